@@ -8,6 +8,7 @@
 
 namespace bdn
 {
+    class PropertyNotifierTable;
 
     /** Base class for most other classes. Provides an implementation
         for IBase.
@@ -15,9 +16,9 @@ namespace bdn
     class Base : BDN_IMPLEMENTS IWeakReferencable
     {
       public:
-        Base() : _weakReferenceState(nullptr) { _refCount = 1; }
+        Base() : _weakReferenceState(nullptr), _propertyNotifierTable(nullptr) { _refCount = 1; }
 
-        Base(const Base &o) : _weakReferenceState(nullptr)
+        Base(const Base &o) : _weakReferenceState(nullptr), _propertyNotifierTable(nullptr)
         {
             // copy nothing. This constructor only exists
             // to ensure that the reference count is not
@@ -166,8 +167,24 @@ namespace bdn
             return ref;
         }
 
+      public:
+        /** Returns the table that holds the "changed" notifiers of the
+           object's properties (see PropertyNotifierTable). If no table exists
+           yet then null is returned, unless createIfNeeded is true.
+
+            This is an internal function that is used by the property macros
+           (see \ref BDN_PROPERTY). It should normally not be called directly.
+           */
+        PropertyNotifierTable *_getPropertyNotifierTable(bool createIfNeeded) const
+        {
+            if (_propertyNotifierTable == nullptr && createIfNeeded)
+                _createPropertyNotifierTable();
+            return _propertyNotifierTable;
+        }
+
       private:
         void _refCountReachedZero();
+        void _createPropertyNotifierTable() const;
 
         mutable volatile std::atomic<int> _refCount;
 
@@ -175,6 +192,10 @@ namespace bdn
         friend struct WeakReferenceState_;
 
         std::atomic<WeakReferenceState_ *> _weakReferenceState;
+
+        // allocated on demand. Property notifiers are rarely used, so we do
+        // not want to pay for them in objects that do not need them.
+        mutable PropertyNotifierTable *_propertyNotifierTable;
     };
 }
 
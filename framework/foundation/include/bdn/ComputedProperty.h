@@ -0,0 +1,260 @@
+#ifndef BDN_ComputedProperty_H_
+#define BDN_ComputedProperty_H_
+
+#include <bdn/IPropertyReadAccessor.h>
+#include <bdn/PropertyNotifier.h>
+#include <bdn/SimpleNotifier.h>
+
+#include <functional>
+#include <vector>
+
+namespace bdn
+{
+
+    template <typename VALUE_TYPE> class ComputedProperty;
+    class ComputedPropertyBase;
+
+    /** Records the dependencies of a ComputedProperty while its value is
+       computed.
+
+        The compute function of a ComputedProperty gets a tracker object as its
+       parameter. It must read all properties that the value depends on via
+       read(). The tracker subscribes to the change notifications of these
+       properties and returns their current value.
+
+        \code
+
+        P<ComputedProperty<String>> fullName = newObj<ComputedProperty<String>>(
+            [person](ComputedPropertyTracker &tracker) {
+                return tracker.read(BDN_PROPERTY_READ_ACCESSOR(*person, firstName)) + " " +
+                       tracker.read(BDN_PROPERTY_READ_ACCESSOR(*person, lastName));
+            });
+
+        \endcode
+    */
+    class ComputedPropertyTracker
+    {
+      public:
+        /** Returns the current value of the property that the accessor refers
+           to and records it as a dependency.*/
+        template <class ACCESSOR_TYPE> typename ACCESSOR_TYPE::ValueType read(const ACCESSOR_TYPE &accessor);
+
+        /** Returns the current value of another computed property and records
+           it as a dependency.
+
+            Computed properties are tracked via their invalidation instead of
+           their changed notifier. That way the whole chain of dependent
+           computed properties is marked dirty before any of them is
+           recomputed.*/
+        template <class VALUE_TYPE> VALUE_TYPE read(const ComputedProperty<VALUE_TYPE> &property);
+
+      private:
+        friend class ComputedPropertyBase;
+
+        struct Dependency
+        {
+            const void *key;
+            std::function<void()> unsubscribe;
+        };
+
+        ComputedPropertyTracker(ComputedPropertyBase *owner, std::vector<Dependency> &&previousDependencies)
+            : _owner(owner), _previousDependencies(std::move(previousDependencies))
+        {}
+
+        /** Returns true if the dependency with the specified key was already
+           recorded. If it was recorded during the previous computation then
+           its subscription is reused.*/
+        bool reuseDependency(const void *key);
+
+        ComputedPropertyBase *_owner;
+        std::vector<Dependency> _previousDependencies;
+        std::vector<Dependency> _dependencies;
+    };
+
+    /** Non-template base class of ComputedProperty.*/
+    class ComputedPropertyBase : public Base
+    {
+      public:
+        ~ComputedPropertyBase();
+
+        /** Returns true if the cached value is out of date (or has never been
+           computed).*/
+        bool isDirty() const { return _dirty; }
+
+        /** Marks the cached value as out of date. This is called automatically
+           when a dependency changes, but it can also be called manually if the
+           value depends on state that is not a property.*/
+        void invalidate();
+
+        /** Returns the number of dependencies that were recorded during the
+           last computation.*/
+        size_t getDependencyCount() const { return _dependencies.size(); }
+
+      protected:
+        ComputedPropertyBase() {}
+
+        /** Computes the value and stores it. All dependencies must be read via
+           the tracker.*/
+        virtual void computeValue(ComputedPropertyTracker &tracker) const = 0;
+
+        /** Returns true if the changed notifier of the property has been
+           requested. In that case invalidations are followed by an eager
+           recomputation (see recomputeAndNotify()).*/
+        virtual bool isObserved() const = 0;
+
+        /** Recomputes the value if it is dirty and fires the changed notifier
+           if it differs from the value that was last reported.*/
+        virtual void recomputeAndNotify() = 0;
+
+        /** Computes the value and updates the recorded dependencies.*/
+        void recompute() const;
+
+      private:
+        friend class ComputedPropertyTracker;
+
+        SimpleNotifier<> &invalidated() const;
+
+        mutable std::vector<ComputedPropertyTracker::Dependency> _dependencies;
+        mutable P<SimpleNotifier<>> _invalidatedNotifier;
+        mutable bool _dirty = true;
+        bool _recomputeScheduled = false;
+    };
+
+    /** A read-only property whose value is computed from other properties.
+
+        The value is computed by a function that reads the dependencies via a
+       ComputedPropertyTracker (see there for an example). The property
+       subscribes to the change notifications of everything that was read and
+       marks itself dirty when one of them fires. The value is only recomputed
+       when it is read again - so any number of changes to the dependencies
+       cost at most one recomputation.
+
+        If the changed notifier has been requested then the property
+       recomputes its value after the notification cascade that invalidated it
+       has finished (see PropertyNotificationPhase). The changed notifier only
+       fires if the recomputed value actually differs from the previous one.
+       Since all dependencies are already up to date at that point, subscribers
+       never see a value that was computed from a partially updated state.
+
+        Dependencies are recorded anew each time the value is computed, so
+       compute functions can read different properties depending on the
+       current state.
+
+        ComputedProperty implements IPropertyReadAccessor, so it can be used
+       wherever a property accessor is expected (for example, with \ref
+       BDN_BIND_TO_PROPERTY or as a dependency of another computed property).
+
+        VALUE_TYPE must be default constructible and support the != operator.
+
+        Like the other properties, ComputedProperty is not thread safe.
+        ComputedProperty objects MUST be allocated with newObj / new.
+    */
+    template <typename VALUE_TYPE>
+    class ComputedProperty : public ComputedPropertyBase, BDN_IMPLEMENTS IPropertyReadAccessor<VALUE_TYPE>
+    {
+      public:
+        using ComputeFunc = std::function<VALUE_TYPE(ComputedPropertyTracker &)>;
+
+        ComputedProperty(ComputeFunc computeFunc) : _computeFunc(computeFunc) {}
+
+        /** Returns the current value. The value is recomputed if it is
+           dirty.*/
+        VALUE_TYPE get() const override
+        {
+            if (isDirty())
+                recompute();
+
+            return _value;
+        }
+
+        IPropertyNotifier<VALUE_TYPE> &changed() const override
+        {
+            if (_changedNotifier == nullptr) {
+                _changedNotifier = newObj<PropertyNotifier<VALUE_TYPE>>();
+
+                // we have to know our dependencies to be able to report
+                // changes.
+                if (isDirty())
+                    recompute();
+
+                // the current value is what subscribers compare against.
+                _changedSinceLastNotify = false;
+            }
+
+            return *_changedNotifier;
+        }
+
+      protected:
+        void computeValue(ComputedPropertyTracker &tracker) const override
+        {
+            VALUE_TYPE newValue = _computeFunc(tracker);
+
+            if (newValue != _value) {
+                _value = newValue;
+                _changedSinceLastNotify = true;
+            }
+        }
+
+        bool isObserved() const override { return _changedNotifier != nullptr; }
+
+        void recomputeAndNotify() override
+        {
+            if (isDirty())
+                recompute();
+
+            // the value might also have been recomputed by a reader in the
+            // meantime. So we check whether it differs from what our
+            // subscribers have seen, not from the previous cached value.
+            if (_changedSinceLastNotify) {
+                _changedSinceLastNotify = false;
+                _changedNotifier->notify(*this);
+            }
+        }
+
+      private:
+        ComputeFunc _computeFunc;
+
+        mutable VALUE_TYPE _value{};
+        mutable bool _changedSinceLastNotify = false;
+        mutable P<PropertyNotifier<VALUE_TYPE>> _changedNotifier;
+    };
+
+    template <class ACCESSOR_TYPE>
+    inline typename ACCESSOR_TYPE::ValueType ComputedPropertyTracker::read(const ACCESSOR_TYPE &accessor)
+    {
+        using ValueType = typename ACCESSOR_TYPE::ValueType;
+
+        IPropertyNotifier<ValueType> &notifier = accessor.changed();
+
+        if (!reuseDependency(&notifier)) {
+            ComputedPropertyBase *owner = _owner;
+            P<INotifierSubscription> sub = notifier.subscribeParamless([owner]() { owner->invalidate(); });
+
+            // the notifier is kept alive until we unsubscribe.
+            P<IPropertyNotifier<ValueType>> notifierRef = &notifier;
+            _dependencies.push_back(Dependency{&notifier, [notifierRef, sub]() { notifierRef->unsubscribe(sub); }});
+        }
+
+        return accessor.get();
+    }
+
+    template <class VALUE_TYPE>
+    inline VALUE_TYPE ComputedPropertyTracker::read(const ComputedProperty<VALUE_TYPE> &property)
+    {
+        const ComputedPropertyBase &propertyBase = property;
+
+        if (!reuseDependency(&propertyBase)) {
+            ComputedPropertyBase *owner = _owner;
+            SimpleNotifier<> &invalidated = propertyBase.invalidated();
+            P<INotifierSubscription> sub = invalidated.subscribeParamless([owner]() { owner->invalidate(); });
+
+            P<const ComputedPropertyBase> propertyRef = &propertyBase;
+            _dependencies.push_back(
+                Dependency{&propertyBase, [propertyRef, sub]() { propertyRef->invalidated().unsubscribe(sub); }});
+        }
+
+        return property.get();
+    }
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef BDN_DispatchOrigin_H_
+#define BDN_DispatchOrigin_H_
+
+namespace bdn
+{
+
+    /** Identifies the place in the source code that enqueued a dispatcher
+       item.
+
+        Dispatchers that support it (like GenericDispatcher) record the origin
+       of each item when it is enqueued. Diagnostic tools like StallWatchdog
+       use it to report where a slow item came from.
+
+        The origin is taken from the innermost DispatchOrigin::Scope that is
+       active in the enqueuing thread (see #BDN_DISPATCH_ORIGIN_SCOPE). If no
+       scope is active then dispatchers fall back to recording the type name
+       of the enqueued function object. For lambdas that name usually contains
+       the name of the function that created the lambda, so it is still a
+       useful hint.
+
+        DispatchOrigin only stores pointers to static strings (like those
+       produced by __FILE__), so it is cheap to copy and can be stored with
+       every item.
+        */
+    struct DispatchOrigin
+    {
+        DispatchOrigin() = default;
+
+        DispatchOrigin(const char *file, int line) : file(file), line(line) {}
+
+        /** The source file name (usually __FILE__) or null if unknown.*/
+        const char *file = nullptr;
+
+        /** The line number in the source file.*/
+        int line = 0;
+
+        /** The (implementation specific) type name of the enqueued function
+           object, or null. This is only set if file is null.*/
+        const char *callableTypeName = nullptr;
+
+        bool isKnown() const { return file != nullptr || callableTypeName != nullptr; }
+
+        /** Returns a human readable description of the origin. For example:
+           "LayoutCoordinator.cpp:65".*/
+        String toString() const;
+
+        /** Returns the origin from the innermost Scope that is active in the
+         * current thread. Returns an unknown origin if there is no scope.*/
+        static DispatchOrigin getCurrent();
+
+        class Scope;
+    };
+
+    /** Sets the current origin of the calling thread for the lifetime of the
+       Scope object. Use #BDN_DISPATCH_ORIGIN_SCOPE instead of using this class
+       directly.*/
+    class DispatchOrigin::Scope
+    {
+      public:
+        Scope(const DispatchOrigin &origin);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+      private:
+        DispatchOrigin _prevOrigin;
+    };
+}
+
+/** \def BDN_DISPATCH_ORIGIN_SCOPE()
+
+    Marks the current source code location as the origin of all dispatcher
+   items that are enqueued by the current thread until the end of the
+   enclosing scope (see DispatchOrigin).
+
+    \code
+
+    void MyClass::scheduleUpdate()
+    {
+        BDN_DISPATCH_ORIGIN_SCOPE();
+
+        asyncCallFromMainThread( ... );
+    }
+
+    \endcode
+*/
+#define BDN_DISPATCH_ORIGIN_SCOPE() bdn::DispatchOrigin::Scope bdnDispatchOriginScope_(bdn::DispatchOrigin(__FILE__, __LINE__))
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef BDN_FastMutex_H_
+#define BDN_FastMutex_H_
+
+#include <bdn/SpinLock.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace bdn
+{
+
+    /** A lightweight, non-recursive mutex.
+
+        FastMutex provides the same interface as bdn::Mutex (including the
+       Lock and Unlock helper classes), so it can be used as a drop-in
+       replacement in generic code like NotifierBase. However, there are two
+       important differences:
+
+        - FastMutex is NOT recursive. A thread must not lock a FastMutex that it
+       already holds. Doing so will cause a deadlock.
+
+        - FastMutex does not derive from Base. It has no reference count and no
+       virtual functions. It is only as large as its lock state.
+
+        On Linux and Android, FastMutex is implemented directly on top of the
+       futex system call. Locking and unlocking an uncontended FastMutex is a
+       single atomic instruction and never enters the kernel. When the mutex is
+       contended, the waiting thread first spins for a short while (since
+       critical sections are usually short, the mutex is often released before
+       it would be worthwhile to go to sleep). The spin duration adapts to how
+       long it took to acquire the mutex in previous contended cases. Only if
+       spinning does not succeed does the thread go to sleep in the kernel.
+
+        On other platforms FastMutex is a thin wrapper around std::mutex.
+        */
+    class FastMutex
+    {
+      public:
+        FastMutex() = default;
+
+        FastMutex(const FastMutex &) = delete;
+        FastMutex &operator=(const FastMutex &) = delete;
+
+#if BDN_HAVE_FUTEX
+
+        void lock()
+        {
+            uint32_t expected = unlocked;
+            if (!_state.compare_exchange_strong(expected, locked, std::memory_order_acquire,
+                                                std::memory_order_relaxed))
+                lockSlow();
+        }
+
+        /** Tries to acquire the mutex without waiting. Returns true if the
+         * mutex was acquired.*/
+        bool tryLock()
+        {
+            uint32_t expected = unlocked;
+            return _state.compare_exchange_strong(expected, locked, std::memory_order_acquire,
+                                                  std::memory_order_relaxed);
+        }
+
+        void unlock()
+        {
+            // if someone is sleeping then we have to wake one of them up.
+            if (_state.exchange(unlocked, std::memory_order_release) == lockedWithWaiters)
+                wakeWaiter();
+        }
+
+#else
+
+        void lock() { _mutex.lock(); }
+
+        bool tryLock() { return _mutex.try_lock(); }
+
+        void unlock() { _mutex.unlock(); }
+
+#endif
+
+        /** Represents a lock on a FastMutex object. See Mutex::Lock.*/
+        class Lock
+        {
+          public:
+            Lock(FastMutex &mutex) : _mutex(mutex) { _mutex.lock(); }
+
+            Lock(FastMutex *mutex) : Lock(*mutex) {}
+
+            // prevent copying of the lock object
+            Lock(const Lock &) = delete;
+            Lock &operator=(const Lock &) = delete;
+
+            ~Lock() { _mutex.unlock(); }
+
+          private:
+            FastMutex &_mutex;
+        };
+
+        /** Temporarily unlocks a FastMutex. See Mutex::Unlock.*/
+        class Unlock
+        {
+          public:
+            Unlock(FastMutex &mutex) : _mutex(mutex) { _mutex.unlock(); }
+
+            Unlock(FastMutex *mutex) : Unlock(*mutex) {}
+
+            // prevent copying of the unlock object
+            Unlock(const Unlock &) = delete;
+            Unlock &operator=(const Unlock &) = delete;
+
+            ~Unlock() { _mutex.lock(); }
+
+          private:
+            FastMutex &_mutex;
+        };
+
+      private:
+#if BDN_HAVE_FUTEX
+        void lockSlow();
+        void wakeWaiter();
+
+        enum : uint32_t
+        {
+            unlocked = 0,
+            locked = 1,
+            // locked and at least one thread is (or might be) sleeping in
+            // the kernel.
+            lockedWithWaiters = 2
+        };
+
+        std::atomic<uint32_t> _state{unlocked};
+
+        // running average of the number of spin iterations that were needed
+        // to acquire the mutex in the contended case.
+        std::atomic<int> _spinEstimate{0};
+#else
+        std::mutex _mutex;
+#endif
+    };
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <bdn/AppRunnerBase.h>
 #include <bdn/GenericDispatcher.h>
+#include <bdn/StallWatchdog.h>
 
 namespace bdn
 {
@@ -70,6 +71,13 @@ namespace bdn
 
             mainLoop();
 
+#if BDN_HAVE_THREADS
+            if (_stallWatchdog != nullptr) {
+                _stallWatchdog->stop();
+                _stallWatchdog->logStatistics();
+            }
+#endif
+
             terminating();
 
             {
@@ -81,6 +89,28 @@ namespace bdn
 
         P<IDispatcher> getMainDispatcher() override { return _dispatcher; }
 
+#if BDN_HAVE_THREADS
+        /** Starts a watchdog that reports when an item on the main thread
+           executes for longer than budgetSeconds (see StallWatchdog). The
+           watchdog is disabled by default.
+
+            The watchdog is stopped and its statistics are logged when the main
+           loop ends. The returned object can be used to query the stall
+           statistics at any time.
+
+            If the watchdog was already enabled then it is replaced with a new
+           one.*/
+        P<StallWatchdog> enableStallWatchdog(double budgetSeconds = 0.1)
+        {
+            if (_stallWatchdog != nullptr)
+                _stallWatchdog->stop();
+
+            _stallWatchdog = newObj<StallWatchdog>(_dispatcher, budgetSeconds);
+
+            return _stallWatchdog;
+        }
+#endif
+
       protected:
         virtual bool shouldExit() const
         {
@@ -119,6 +149,10 @@ namespace bdn
 
         P<GenericDispatcher> _dispatcher;
 
+#if BDN_HAVE_THREADS
+        P<StallWatchdog> _stallWatchdog;
+#endif
+
         bool _exitRequested = false;
         int _exitCode = 0;
     };
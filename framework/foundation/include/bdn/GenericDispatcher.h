@@ -2,14 +2,19 @@
 #define BDN_GenericDispatcher_H_
 
 #include <bdn/IDispatcher.h>
+#include <bdn/DispatchOrigin.h>
+#include <bdn/FastMutex.h>
 #include <bdn/Signal.h>
 #include <bdn/ThreadRunnableBase.h>
 #include <bdn/log.h>
 #include <bdn/IAppRunner.h>
 #include <bdn/List.h>
+#include <bdn/Array.h>
+#include <bdn/Thread.h>
 
 #include <chrono>
 #include <functional>
+#include <map>
 
 namespace bdn
 {
@@ -20,6 +25,18 @@ namespace bdn
         This can also be used if an independent dispatcher is needed in a
        secondary work thread.
 
+        A GenericDispatcher can also be drained by multiple threads at the same
+       time (see WorkerPool). In that case it acts as a background work queue:
+       items are still taken from the queues in priority order, but several
+       items can execute concurrently. Items that must not run concurrently
+       with each other can be enqueued with enqueueSerial() and a common
+       serial key.
+
+        The dispatcher records the origin of each item when it is enqueued
+       (see DispatchOrigin) and provides information about the item that is
+       currently executing (see getActivity()). This is used by StallWatchdog
+       to detect and report stalls.
+
         */
     class GenericDispatcher : public Base, BDN_IMPLEMENTS IDispatcher
     {
@@ -30,10 +47,34 @@ namespace bdn
         {
             // disposes the dispatcher and clears any pending items from the
             // queue (without executing them).
-            Mutex::Lock lock(_mutex);
 
-            for (int priorityQueueIndex = 0; priorityQueueIndex < priorityCount; priorityQueueIndex++) {
-                List<std::function<void()>> &queue = _queues[priorityQueueIndex];
+            // we move the items out of the dispatcher and destroy them after
+            // the mutex was released. The destructors of the items can execute
+            // arbitrary code (including enqueuing new items), so we must not
+            // hold our (non-recursive) mutex while they run.
+            List<Item> queues[priorityCount + 1];
+            std::map<TimedItemKey, TimedItem> timedItemMap;
+            std::map<String, List<Item>> serialKeyMap;
+
+            {
+                FastMutex::Lock lock(_mutex);
+
+                for (int priorityQueueIndex = 0; priorityQueueIndex < priorityCount; priorityQueueIndex++)
+                    queues[priorityQueueIndex].swap(_queues[priorityQueueIndex]);
+
+                timedItemMap.swap(_timedItemMap);
+                serialKeyMap.swap(_serialKeyMap);
+
+                _queuedItemCount = 0;
+            }
+
+            // the items that were waiting for their serial key are cleared
+            // together with the normal queues.
+            for (auto &serialKeyEntry : serialKeyMap)
+                queues[priorityCount].splice(queues[priorityCount].end(), serialKeyEntry.second);
+
+            for (int priorityQueueIndex = 0; priorityQueueIndex < priorityCount + 1; priorityQueueIndex++) {
+                List<Item> &queue = queues[priorityQueueIndex];
 
                 // remove the objects one by one so that we can ignore
                 // exceptions that happen in the destructor.
@@ -41,7 +82,7 @@ namespace bdn
                     BDN_LOG_AND_IGNORE_EXCEPTION(
                         { // make a copy so that pop_front is not aborted if the
                           // destructor fails.
-                            std::function<void()> item = queue.front();
+                            Item item = queue.front();
                             queue.pop_front();
                         },
                         "Error clearing GenericDispatcher item during dispose. "
@@ -50,13 +91,13 @@ namespace bdn
             }
 
             // also remove timed items
-            while (!_timedItemMap.empty()) {
+            while (!timedItemMap.empty()) {
                 BDN_LOG_AND_IGNORE_EXCEPTION(
                     {
                         // make a copy so that pop_front is not aborted if the
                         // destructor fails.
-                        std::function<void()> func = _timedItemMap.begin()->second.func;
-                        _timedItemMap.erase(_timedItemMap.begin());
+                        std::function<void()> func = timedItemMap.begin()->second.func;
+                        timedItemMap.erase(timedItemMap.begin());
                     },
                     "Error clearing GenericDispatcher timed item during "
                     "dispose. Ignoring.");
@@ -65,19 +106,35 @@ namespace bdn
 
         void enqueue(std::function<void()> func, Priority priority = Priority::normal) override
         {
-            Mutex::Lock lock(_mutex);
+            FastMutex::Lock lock(_mutex);
 
-            getQueue(priority).push_back(func);
+            getQueue(priority).push_back(Item(func, priority, Clock::now(), getOrigin(func)));
+            _queuedItemCount++;
+            updateMaxQueuedItemCount();
 
             _somethingChangedSignal.set();
         }
 
+        /** Like enqueue(), but the item is associated with a "serial key".
+            Items with the same serial key never execute concurrently, even if
+           multiple threads are executing items from the dispatcher (see
+           WorkerPool). They are executed in the order in which they were
+           enqueued - the priority only affects their order relative to items
+           with other keys.
+
+            Items with different keys (and items that were enqueued with
+           enqueue()) can execute concurrently with each other.
+
+            serialKey must not be empty.
+            */
+        void enqueueSerial(const String &serialKey, std::function<void()> func, Priority priority = Priority::normal);
+
         void enqueueInSeconds(double seconds, std::function<void()> func, Priority priority = Priority::normal) override
         {
             if (seconds <= 0)
                 enqueue(func, priority);
             else
-                addTimedItem(Clock::now() + secondsToDuration(seconds), func, priority);
+                addTimedItem(Clock::now() + secondsToDuration(seconds), func, priority, getOrigin(func));
         }
 
         void createTimer(double intervalSeconds, std::function<bool()> func) override
@@ -88,7 +145,11 @@ namespace bdn
             else {
                 Duration interval = secondsToDuration(intervalSeconds);
 
-                P<Timer> timer = newObj<Timer>(this, func, interval);
+                DispatchOrigin origin = DispatchOrigin::getCurrent();
+                if (!origin.isKnown())
+                    origin.callableTypeName = func.target_type().name();
+
+                P<Timer> timer = newObj<Timer>(this, func, interval, origin);
 
                 timer->scheduleNextEvent();
             }
@@ -111,6 +172,77 @@ namespace bdn
            elapsed.*/
         bool waitForNext(double timeoutSeconds);
 
+        /** Statistics about the items in the dispatcher. See getStatistics().*/
+        struct Statistics
+        {
+            /** The number of items that are ready to be executed and waiting
+               for a thread to pick them up. This includes items that wait
+               for an item with the same serial key to finish.*/
+            int64_t queuedItemCount = 0;
+
+            /** The highest value of queuedItemCount since the dispatcher was
+             * created or resetStatistics() was called.*/
+            int64_t maxQueuedItemCount = 0;
+
+            /** The number of timed items (see enqueueInSeconds() and
+             * createTimer()) whose scheduled time has not been reached yet.*/
+            int64_t timedItemCount = 0;
+
+            /** The number of items that are currently executing.*/
+            int64_t executingItemCount = 0;
+
+            /** The number of items that have started executing.*/
+            int64_t executedItemCount = 0;
+
+            /** The average time in seconds that the executed items waited
+               from the time they became ready (i.e. from the time they were
+               enqueued or their scheduled time was reached) until they started
+               executing.*/
+            double averageWaitSeconds = 0;
+
+            /** The maximum wait time in seconds (see averageWaitSeconds).*/
+            double maxWaitSeconds = 0;
+        };
+
+        /** Returns statistics about the current state of the dispatcher and
+           about the items that were executed so far.
+
+            This can be called from any thread.*/
+        Statistics getStatistics() const;
+
+        /** Resets the accumulated statistics (the executed item count, the wait
+           times and the maximum queued item count).*/
+        void resetStatistics();
+
+        /** Information about the item that the dispatcher is currently
+         * executing. See getActivity().*/
+        struct Activity
+        {
+            /** True if an item is currently executing.*/
+            bool executing = false;
+
+            /** Incremented each time an item starts executing. Can be used to
+               detect if the executing item has changed between two
+               getActivity() calls.*/
+            int64_t itemSequenceNumber = 0;
+
+            /** The number of seconds that the current item has been
+             * executing.*/
+            double executingSeconds = 0;
+
+            /** The origin of the current item (see DispatchOrigin).*/
+            DispatchOrigin origin;
+        };
+
+        /** Returns information about the item that is currently executing.
+            This is meant to be called from other threads to monitor the
+           dispatcher (see StallWatchdog).
+
+            If multiple threads execute items from the dispatcher (see
+           WorkerPool) then the information refers to the item that started
+           most recently.*/
+        Activity getActivity() const;
+
         /** Convenience implementation of a IThreadRunnable for a thread that
            has a GenericDispatcher at its core.
 
@@ -168,9 +300,61 @@ namespace bdn
             P<GenericDispatcher> _dispatcher;
         };
 
-      private:
-        bool getNextReady(std::function<void()> &func, bool remove);
+#if BDN_HAVE_THREADS
+
+        /** Runs a set of threads that all execute items from the same
+           GenericDispatcher.
+
+            This turns the dispatcher into a background work queue that
+           executes up to threadCount items in parallel. Priorities are
+           respected (higher priority items are always taken from the queue
+           first), but with more than one thread the items do not necessarily
+           finish in that order. Use GenericDispatcher::enqueueSerial() for
+           items that must not execute concurrently.
+
+            Example:
+
+            \code
+
+            P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+            P<GenericDispatcher::WorkerPool> pool = newObj<GenericDispatcher::WorkerPool>( dispatcher, 4 );
 
+            dispatcher->enqueue( ... );
+
+            // to stop the worker threads:
+            pool->stop();
+
+            \endcode
+
+            The threads are also stopped when the pool object is destroyed.
+            */
+        class WorkerPool : public Base
+        {
+          public:
+            /** Starts threadCount threads for the dispatcher. If threadCount
+               is 0 or negative then one thread per hardware thread is
+               started.*/
+            WorkerPool(GenericDispatcher *dispatcher, int threadCount);
+            ~WorkerPool();
+
+            /** Returns the number of worker threads.*/
+            int getThreadCount() const { return (int)_threads.size(); }
+
+            /** Stops all worker threads and waits for them to end. Items that
+               are currently executing are finished first. Items that are still
+               in the queue remain there.
+
+                It is no problem to call stop multiple times.*/
+            void stop();
+
+          private:
+            P<GenericDispatcher> _dispatcher;
+            Array<P<Thread>> _threads;
+        };
+
+#endif
+
+      private:
         typedef std::chrono::steady_clock Clock;
         typedef Clock::time_point TimePoint;
         typedef Clock::duration Duration;
@@ -180,7 +364,7 @@ namespace bdn
             return Duration((Duration::rep)(seconds * Duration::period::den / Duration::period::num));
         }
 
-        double durationToSeconds(const Duration &dur)
+        double durationToSeconds(const Duration &dur) const
         {
             return ((double)dur.count()) * Duration::period::num / Duration::period::den;
         }
@@ -202,11 +386,67 @@ namespace bdn
             throw InvalidArgumentError("Invalid dispatcher item priority: " + std::to_string((int)priority));
         }
 
-        List<std::function<void()>> &getQueue(Priority priority) { return _queues[priorityToQueueIndex(priority)]; }
+        struct Item
+        {
+            Item() = default;
+
+            Item(std::function<void()> func, Priority priority, TimePoint readyTime, const DispatchOrigin &origin,
+                 const String &serialKey = String())
+                : func(func), priority(priority), readyTime(readyTime), origin(origin), serialKey(serialKey)
+            {}
+
+            std::function<void()> func;
+            Priority priority = Priority::normal;
+
+            // the time when the item became ready for execution. Used for the
+            // wait time statistics.
+            TimePoint readyTime;
+
+            DispatchOrigin origin;
+
+            // empty if the item has no serial key
+            String serialKey;
+        };
+
+        /** Gets the next item that is ready to be executed. _mutex must be
+         * locked when this is called.*/
+        bool getNextReady(Item &item, bool remove);
+
+        /** Called after an item with a serial key has finished executing.
+           Moves the next item with the same key to the normal queue (if there
+           is one). _mutex must be locked when this is called.*/
+        void releaseSerialKey(const String &serialKey);
+
+        /** Updates the statistics after an item was taken from the queue for
+         * execution. _mutex must be locked when this is called.*/
+        void itemStarting(const Item &item);
+
+        /** Returns the origin for an item that is currently being
+         * enqueued.*/
+        static DispatchOrigin getOrigin(const std::function<void()> &func)
+        {
+            DispatchOrigin origin = DispatchOrigin::getCurrent();
+
+            // fall back to the type of the function object. For lambdas that
+            // usually includes the name of the enclosing function.
+            if (!origin.isKnown())
+                origin.callableTypeName = func.target_type().name();
+
+            return origin;
+        }
+
+        void updateMaxQueuedItemCount()
+        {
+            if (_queuedItemCount > _maxQueuedItemCount)
+                _maxQueuedItemCount = _queuedItemCount;
+        }
+
+        List<Item> &getQueue(Priority priority) { return _queues[priorityToQueueIndex(priority)]; }
 
-        void addTimedItem(TimePoint scheduledTime, std::function<void()> func, Priority priority)
+        void addTimedItem(TimePoint scheduledTime, std::function<void()> func, Priority priority,
+                          const DispatchOrigin &origin)
         {
-            Mutex::Lock lock(_mutex);
+            FastMutex::Lock lock(_mutex);
 
             // we enqueue all timed items in a map, so that the set of scheduled
             // items remains sorted automatically and we can easily find the
@@ -221,10 +461,13 @@ namespace bdn
             TimedItem &item = _timedItemMap[key];
             item.func = func;
             item.priority = priority;
+            item.origin = origin;
 
             _somethingChangedSignal.set();
         }
 
+        /** Moves all timed items whose scheduled time has been reached to the
+         * normal queues. _mutex must be locked when this is called.*/
         void enqueueTimedItemsIfTimeReached()
         {
             if (!_timedItemMap.empty()) {
@@ -238,7 +481,7 @@ namespace bdn
                     const TimedItemKey &key(it->first);
                     const TimedItem &val(it->second);
 
-                    auto &scheduledTime = std::get<0>(key);
+                    TimePoint scheduledTime = std::get<0>(key);
 
                     if (scheduledTime > now) {
                         // the scheduled time is in the future. We can stop
@@ -248,7 +491,13 @@ namespace bdn
                         break;
                     }
 
-                    enqueue(val.func, val.priority);
+                    // note that we do not need to set _somethingChangedSignal
+                    // here, since we are only called by the consumer side
+                    // (which checks the queues afterwards anyway).
+                    getQueue(val.priority).push_back(Item(val.func, val.priority, scheduledTime, val.origin));
+                    _queuedItemCount++;
+                    updateMaxQueuedItemCount();
+
                     _timedItemMap.erase(it);
                 }
             }
@@ -257,16 +506,21 @@ namespace bdn
         class Timer : public Base
         {
           public:
-            Timer(GenericDispatcher *dispatcherWeak, std::function<bool()> func, Duration interval)
+            Timer(GenericDispatcher *dispatcherWeak, std::function<bool()> func, Duration interval,
+                  const DispatchOrigin &origin)
             {
                 _dispatcherWeak = dispatcherWeak;
+                _origin = origin;
 
                 _nextEventTime = Clock::now() + interval;
                 _func = func;
                 _interval = interval;
             }
 
-            void scheduleNextEvent() { _dispatcherWeak->addTimedItem(_nextEventTime, Caller(this), Priority::normal); }
+            void scheduleNextEvent()
+            {
+                _dispatcherWeak->addTimedItem(_nextEventTime, Caller(this), Priority::normal, _origin);
+            }
 
           private:
             class Caller
@@ -343,6 +597,8 @@ namespace bdn
             TimePoint _nextEventTime;
             std::function<bool()> _func;
             Duration _interval;
+
+            DispatchOrigin _origin;
         };
         friend class Timer;
 
@@ -352,15 +608,37 @@ namespace bdn
         {
             std::function<void()> func;
             Priority priority = Priority::normal;
+            DispatchOrigin origin;
         };
 
-        Mutex _mutex;
+        // note that the dispatcher never needs to lock its mutex recursively.
+        // So we can use the cheaper, non-recursive FastMutex.
+        mutable FastMutex _mutex;
 
-        List<std::function<void()>> _queues[priorityCount];
+        List<Item> _queues[priorityCount];
 
         std::map<TimedItemKey, TimedItem> _timedItemMap;
         int64_t _timedItemCounter = 0;
 
+        // contains an entry for each serial key that has an item in the
+        // queues or currently executing. The entry value is the list of items
+        // with that key that have to wait until that item has finished.
+        std::map<String, List<Item>> _serialKeyMap;
+
+        int64_t _queuedItemCount = 0;
+        int64_t _maxQueuedItemCount = 0;
+        int64_t _executingItemCount = 0;
+        int64_t _executedItemCount = 0;
+        Duration _totalWaitDuration = Duration::zero();
+        Duration _maxWaitDuration = Duration::zero();
+
+        // information about the most recently started item. See
+        // getActivity().
+        int64_t _itemSequenceNumber = 0;
+        bool _currentItemExecuting = false;
+        TimePoint _currentItemStartTime;
+        DispatchOrigin _currentItemOrigin;
+
         Signal _somethingChangedSignal;
     };
 }
@@ -27,6 +27,15 @@ namespace bdn
         /** Returns the property's current value.*/
         virtual VALUE_TYPE get() const = 0;
 
+        /** Returns a pointer to the stored property value, if the property
+           provides direct access to it (i.e. if its getter returns a const
+           reference). Returns null otherwise.
+
+            This allows the value to be passed on without copying it (see
+           PropertyNotifier). The pointer is only valid until the property
+           value is modified. The default implementation returns null.*/
+        virtual const VALUE_TYPE *getValuePointer() const { return nullptr; }
+
         /** Returns the notifier that fires whenever the property value is
          * changed.*/
         virtual IPropertyNotifier<VALUE_TYPE> &changed() const = 0;
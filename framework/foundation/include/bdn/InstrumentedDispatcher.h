@@ -0,0 +1,149 @@
+#ifndef BDN_InstrumentedDispatcher_H_
+#define BDN_InstrumentedDispatcher_H_
+
+#include <bdn/IDispatcher.h>
+#include <bdn/LatencyHistogram.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+namespace bdn
+{
+
+    /** A dispatcher that forwards all calls to another dispatcher and records
+       latency and throughput statistics about the items that pass through it.
+
+        InstrumentedDispatcher can wrap any IDispatcher implementation (the
+       GenericDispatcher as well as the platform-specific main dispatchers).
+       Instrumentation is optional: only code that enqueues its items through
+       the InstrumentedDispatcher object is measured.
+
+        \code
+
+        P<InstrumentedDispatcher> dispatcher = newObj<InstrumentedDispatcher>( getMainDispatcher() );
+
+        dispatcher->enqueue( ... );
+
+        ...
+
+        dispatcher->logSnapshot("main dispatcher");
+
+        \endcode
+
+        The following data is recorded for each priority:
+
+        - A histogram of the wait time, i.e. the time from the enqueue() call
+       until the item starts executing.
+        - A histogram of the execution time of the items.
+        - The number of items that are currently waiting in the queue and the
+       highest number of waiting items (high-water mark).
+
+        For items enqueued with enqueueInSeconds() and for timer events (see
+       createTimer()) the wait time is replaced by the timer lateness, i.e. the
+       time from the scheduled time until the item actually starts executing.
+       The lateness is recorded in a separate histogram for all priorities.
+
+        Recording is lock-free (see LatencyHistogram), so the instrumentation
+       does not introduce any additional synchronization between the threads
+       that enqueue items and the thread that executes them.
+        */
+    class InstrumentedDispatcher : public Base, BDN_IMPLEMENTS IDispatcher
+    {
+      public:
+        InstrumentedDispatcher(IDispatcher *innerDispatcher);
+
+        /** Returns the dispatcher that actually executes the items.*/
+        P<IDispatcher> getInnerDispatcher() const { return _innerDispatcher; }
+
+        void enqueue(std::function<void()> func, Priority priority = Priority::normal) override;
+
+        void enqueueInSeconds(double seconds, std::function<void()> func, Priority priority = Priority::normal) override;
+
+        void createTimer(double intervalSeconds, std::function<bool()> func) override;
+
+        /** The statistics for a single priority. See getSnapshot().*/
+        struct PrioritySnapshot
+        {
+            /** Time from enqueue() until the item started executing.*/
+            LatencyHistogram::Snapshot waitTime;
+
+            /** Execution time of the items (including timer events).*/
+            LatencyHistogram::Snapshot executionTime;
+
+            /** The number of items that were enqueued and have not started
+             * executing yet.*/
+            int64_t queuedItemCount = 0;
+
+            /** The highest value of queuedItemCount.*/
+            int64_t maxQueuedItemCount = 0;
+        };
+
+        /** A copy of the recorded statistics at a certain point in time.*/
+        struct Snapshot
+        {
+            PrioritySnapshot normal;
+            PrioritySnapshot idle;
+
+            /** Time from the scheduled time of delayed items and timer
+             * events until they started executing.*/
+            LatencyHistogram::Snapshot timerLateness;
+        };
+
+        /** Returns a snapshot of the statistics that were recorded so far.
+            This can be called from any thread.*/
+        Snapshot getSnapshot() const;
+
+        /** Clears the recorded histograms and resets the queue high-water
+         * marks.*/
+        void reset();
+
+        /** Writes the current statistics (see getSnapshot()) to the log.
+            title is included in the log entries to identify the
+           dispatcher.*/
+        void logSnapshot(const String &title) const;
+
+      private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct PriorityData
+        {
+            LatencyHistogram waitTime;
+            LatencyHistogram executionTime;
+
+            std::atomic<int64_t> queuedItemCount{0};
+            std::atomic<int64_t> maxQueuedItemCount{0};
+
+            void itemQueued();
+            PrioritySnapshot getSnapshot() const;
+            void reset();
+        };
+
+        /** The recorded data. This is a separate object because items can
+           outlive the InstrumentedDispatcher object (they are owned by the
+           inner dispatcher).*/
+        class Data : public Base
+        {
+          public:
+            PriorityData &getPriorityData(Priority priority)
+            {
+                return (priority == Priority::idle) ? idle : normal;
+            }
+
+            PriorityData normal;
+            PriorityData idle;
+
+            LatencyHistogram timerLateness;
+        };
+
+        static int64_t nanosSince(Clock::time_point time)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - time).count();
+        }
+
+        P<IDispatcher> _innerDispatcher;
+        P<Data> _data;
+    };
+}
+
+#endif
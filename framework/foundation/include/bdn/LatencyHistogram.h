@@ -0,0 +1,141 @@
+#ifndef BDN_LatencyHistogram_H_
+#define BDN_LatencyHistogram_H_
+
+#include <atomic>
+#include <vector>
+
+namespace bdn
+{
+
+    /** A histogram of durations (in nanoseconds) in the style of an HDR
+       histogram.
+
+        The value range is divided into power-of-two magnitudes, each of which
+       is divided into subBucketCount linear sub-buckets. So the relative
+       error of a recorded value is at most 1/subBucketCount (12.5%), no matter
+       whether the value is a few nanoseconds or several minutes.
+
+        Recording a value is lock-free and wait-free (a few relaxed atomic
+       increments), so record() can be called from any number of threads
+       concurrently and from time-critical code. getSnapshot() can also be
+       called concurrently with record(). Since the individual counters are
+       read one after another, a snapshot that is taken while values are being
+       recorded may be slightly inconsistent (e.g. the total count might
+       include a value whose bucket count is not included yet).
+
+        LatencyHistogram does not derive from Base. It is usually embedded
+       directly in the object that collects the statistics.
+        */
+    class LatencyHistogram
+    {
+      public:
+        enum
+        {
+            /** The number of linear sub-buckets per power of two.*/
+            subBucketCount = 8,
+
+            /** The number of powers of two that are covered. Values above
+               2^magnitudeCount nanoseconds (about 18 minutes) are recorded in
+               the last bucket.*/
+            magnitudeCount = 40,
+
+            bucketCount = (magnitudeCount + 1) * subBucketCount
+        };
+
+        LatencyHistogram();
+
+        LatencyHistogram(const LatencyHistogram &) = delete;
+        LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+        /** Records a value. Negative values are recorded as 0.*/
+        void record(int64_t nanos)
+        {
+            if (nanos < 0)
+                nanos = 0;
+
+            _buckets[getBucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+            _count.fetch_add(1, std::memory_order_relaxed);
+            _totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+
+            int64_t prevMax = _maxNanos.load(std::memory_order_relaxed);
+            while (nanos > prevMax &&
+                   !_maxNanos.compare_exchange_weak(prevMax, nanos, std::memory_order_relaxed)) {
+            }
+        }
+
+        /** Removes all recorded values.*/
+        void reset();
+
+        /** A copy of the histogram data at a certain point in time. See
+         * getSnapshot().*/
+        struct Snapshot
+        {
+            int64_t count = 0;
+            int64_t totalNanos = 0;
+            int64_t maxNanos = 0;
+
+            /** The number of values in each bucket. Has bucketCount entries
+               (or none, if the snapshot was default-constructed).*/
+            std::vector<int64_t> bucketCounts;
+
+            /** Returns the average of the recorded values in nanoseconds (0
+             * if no values were recorded).*/
+            double getMeanNanos() const { return (count > 0) ? ((double)totalNanos) / count : 0; }
+
+            /** Returns the value below which the specified percentage of
+               recorded values lie (percentile is in the range 0..100).
+               The result is the upper bound of the corresponding bucket, but
+               never more than maxNanos. Returns 0 if no values were
+               recorded.*/
+            int64_t getPercentileNanos(double percentile) const;
+
+            /** Returns a short human readable summary of the snapshot.
+                Example: "count=1000 mean=12.3us p50=10.2us p99=80.1us
+               max=1.2ms"*/
+            String toString() const;
+        };
+
+        Snapshot getSnapshot() const;
+
+        /** Returns the bucket that a value is recorded in.*/
+        static int getBucketIndex(int64_t nanos)
+        {
+            // the first magnitude contains the values 0..subBucketCount-1
+            // with one value per bucket. Each following magnitude m contains
+            // the values from subBucketCount*2^(m-1) to subBucketCount*2^m-1,
+            // with 2^(m-1) values per bucket.
+            uint64_t value = (uint64_t)nanos;
+            if (value < subBucketCount)
+                return (int)value;
+
+            int magnitude = 0;
+            uint64_t shifted = value / subBucketCount;
+            while (shifted > 0) {
+                shifted >>= 1;
+                magnitude++;
+            }
+
+            if (magnitude > magnitudeCount)
+                return bucketCount - 1;
+
+            int subBucket = (int)(value >> (magnitude - 1)) - subBucketCount;
+
+            return magnitude * subBucketCount + subBucket;
+        }
+
+        /** Returns the largest value that is recorded in the specified
+         * bucket.*/
+        static int64_t getBucketUpperBound(int bucketIndex);
+
+        /** Formats a duration in nanoseconds for display (e.g. "12.3us").*/
+        static String formatNanos(double nanos);
+
+      private:
+        std::atomic<int64_t> _buckets[bucketCount];
+        std::atomic<int64_t> _count;
+        std::atomic<int64_t> _totalNanos;
+        std::atomic<int64_t> _maxNanos;
+    };
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef BDN_NotificationBatch_H_
+#define BDN_NotificationBatch_H_
+
+#include <bdn/FastMutex.h>
+
+#include <functional>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Collects pending notification deliveries of many notifiers and
+       executes all of them from a single main thread dispatcher item.
+
+        Without a batch every ThreadSafeNotifier::postNotification() call
+       enqueues its own item in the main dispatcher. If many notifiers are
+       updated from a background thread then that can result in a large
+       number of tiny dispatcher items. Notifiers that are connected to a
+       NotificationBatch (see ThreadSafeNotifier::setPostingBatch()) instead
+       add their deliveries to the batch. The batch only enqueues a single
+       dispatcher item while deliveries are pending.
+
+        The deliveries are executed in the order in which they were added.
+
+        NotificationBatch is thread safe. NotificationBatch objects MUST be
+       allocated with newObj / new.
+    */
+    class NotificationBatch : public Base
+    {
+      public:
+        NotificationBatch() {}
+
+        /** Adds a delivery function to the batch. It will be called from the
+           main thread. Can be called from any thread.*/
+        void add(std::function<void()> delivery);
+
+        /** Returns the number of deliveries that are currently pending.*/
+        size_t getPendingCount() const;
+
+      private:
+        void deliver();
+        void scheduleDelivery();
+
+        mutable FastMutex _mutex;
+        std::vector<std::function<void()>> _pending;
+        bool _deliveryScheduled = false;
+    };
+}
+
+#endif
@@ -5,9 +5,9 @@
 #include <bdn/ISyncNotifier.h>
 #include <bdn/DanglingFunctionError.h>
 
-#include <bdn/Map.h>
-
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 namespace bdn
 {
@@ -15,9 +15,11 @@ namespace bdn
     /** Base class for notifier implementations.
 
         The MUTEX_TYPE template parameter indicates the type of the mutex object
-       that the Notifier uses. Pass bdn::Mutex to use a normal mutex. You can
-       also pass bdn::DummyMutex to use a fake mutex that does nothing (thus
-       removing multithread support).
+       that the Notifier uses. Pass bdn::Mutex to use a normal mutex. The
+       notifier never locks its mutex recursively, so the lighter
+       bdn::FastMutex or bdn::SpinLock can also be used. You can also pass
+       bdn::DummyMutex to use a fake mutex that does nothing (thus removing
+       multithread support).
     */
     template <class MUTEX_TYPE, class... ARG_TYPES>
     class NotifierBase : public Base, BDN_IMPLEMENTS INotifierBase<ARG_TYPES...>
@@ -50,15 +52,22 @@ namespace bdn
 
         void unsubscribeAll() override
         {
-            typename MUTEX_TYPE::Lock lock(_mutex);
+            // the functions are destroyed after the mutex was released (see
+            // removeSubscription)
+            FuncList_ garbage;
 
-            _subMap.clear();
+            typename MUTEX_TYPE::Lock lock(_mutex);
 
-            NotificationState *curr = _firstNotificationState;
-            while (curr != nullptr) {
-                curr->nextItemIt = _subMap.end();
-                curr = curr->next;
+            for (Slot_ &slot : _slots) {
+                if (!slot.removed)
+                    markRemoved(slot);
             }
+
+            for (Slot_ &slot : _pendingSlots)
+                garbage.push_back(std::move(slot.func));
+            _pendingSlots.clear();
+
+            compactIfIdle(garbage);
         }
 
       protected:
@@ -88,87 +97,81 @@ namespace bdn
         template <typename CALL_MAKER_TYPE, typename... ADDITIONAL_CALL_MAKER_ARGS>
         void notifyImpl(CALL_MAKER_TYPE callMaker, ADDITIONAL_CALL_MAKER_ARGS... additionalCallMakerArgs)
         {
+            // functions of subscriptions that are removed during the
+            // notification are destroyed here, after the mutex was released.
+            FuncList_ garbage;
+
             // we do not want to hold a mutex while we call each subscriber.
             // That would create the potential for deadlocks. However, we need
             // to hold a mutex to access our internal structures, up to the
             // point in time when we actually make the call.
+            typename MUTEX_TYPE::Lock lock(_mutex);
 
-            {
-                typename MUTEX_TYPE::Lock lock(_mutex);
-
-                // We also need to ensure that subscribers that are removed
-                // while our notification call is running are not called after
-                // they are removed (unless their specific call has already
-                // started).
-
-                // When we have an async notifier then there is usually only one
-                // notification call active at any given point in time, since
-                // all of them are made from the main thread. However, if the
-                // event loop does work somewhere in an inner function (e.g. by
-                // a modal dialog created by some other framework) then a second
-                // notification call might be executed before the first can
-                // finish. The mutex does not protect against this since both
-                // calls would happen in the same thread (the main thread).
-
-                // When we are a synchronous notifier then there can also be
-                // additional notify calls happening while we are inside the
-                // loop (if one of our subscribers causes another notification
-                // to happen). So we also have to be re-entrant in that case.
-
-                NotificationState state;
-
-                state.nextItemIt = _subMap.begin();
-
-                activateNotificationState(&state);
-
-                try {
-                    while (state.nextItemIt != _subMap.end()) {
-                        std::pair<int64_t, Sub_> item = *state.nextItemIt;
-
-                        // increase the iterator before we call the notification
-                        // function. That is necessary for cases when someone
-                        // removes the next item in our map before we get to it.
-                        // Note that the unsubscribe function will update the
-                        // iterator properly, to ensure that it remains valid.
-                        state.nextItemIt++;
-
-                        // now we have to release the mutex. At this point in
-                        // time the function might be unsubscribed by another
-                        // thread, but we cannot stop the call once we started
-                        // it. We also cannot block unsubscribes during this
-                        // call, since that can open up the potential for
-                        // deadlocks. So the caller of unsubscribe has to deal
-                        // with the fact that the function might be called once
-                        // more directly after unsubscribe finishes.
-
-                        try {
-                            typename MUTEX_TYPE::Unlock unlock(_mutex);
-
-                            // note: we MUST NOT use std::forward here, since we
-                            // may have to call multiple subscribers.
-                            // std::forward might convert the temporary object
-                            // to a move reference, this the
-                            // additionalCallMakerArgs variable might otherwise
-                            // be invalidated by the first subscriber call.
-                            callMaker(item.second.func, additionalCallMakerArgs...);
-                        }
-                        catch (DanglingFunctionError &) {
-                            // this is a perfectly normal case. It means that
-                            // the target function was a weak reference and the
-                            // target object has been destroyed. Just remove it
-                            // from our list and ignore the exception.
-
-                            unsubscribeById(item.first);
-                        }
+            // While at least one notification is active the slot array is
+            // never modified structurally. New subscriptions go to
+            // _pendingSlots and removed subscriptions are only marked as
+            // removed (tombstones). So the slots keep their positions and
+            // we can call the subscribed functions in place, without copying
+            // them.
+
+            // Note that there can be multiple active notifications, even in
+            // the same thread. When we are a synchronous notifier then a
+            // subscriber can cause another notification to happen. And
+            // async notifications can overlap when the event loop is worked
+            // from an inner function (e.g. by a modal dialog created by some
+            // other framework).
+            _activeNotificationCount++;
+
+            try {
+                size_t slotCount = _slots.size();
+
+                for (size_t i = 0; i < slotCount; i++) {
+                    Slot_ &slot = _slots[i];
+
+                    // subscribers that are removed before their call started
+                    // must not be called.
+                    if (slot.removed)
+                        continue;
+
+                    // now we have to release the mutex. At this point in time
+                    // the function might be unsubscribed by another thread,
+                    // but we cannot stop the call once we started it. We also
+                    // cannot block unsubscribes during this call, since that
+                    // can open up the potential for deadlocks. So the caller
+                    // of unsubscribe has to deal with the fact that the
+                    // function might be called once more directly after
+                    // unsubscribe finishes.
+
+                    try {
+                        typename MUTEX_TYPE::Unlock unlock(_mutex);
+
+                        // note: we MUST NOT use std::forward here, since we
+                        // may have to call multiple subscribers. std::forward
+                        // might convert the temporary object to a move
+                        // reference, this the additionalCallMakerArgs variable
+                        // might otherwise be invalidated by the first
+                        // subscriber call.
+                        callMaker(slot.func, additionalCallMakerArgs...);
+                    }
+                    catch (DanglingFunctionError &) {
+                        // this is a perfectly normal case. It means that the
+                        // target function was a weak reference and the target
+                        // object has been destroyed. Just remove it from our
+                        // list and ignore the exception. Note that the mutex
+                        // is locked again at this point.
+                        if (!slot.removed)
+                            markRemoved(slot);
                     }
                 }
-                catch (...) {
-                    deactivateNotificationState(&state);
-                    throw;
-                }
-
-                deactivateNotificationState(&state);
             }
+            catch (...) {
+                _activeNotificationCount--;
+                compactIfIdle(garbage);
+                throw;
+            }
+
+            _activeNotificationCount--;
+            compactIfIdle(garbage);
         }
 
         /** A default call maker implementation that simply calls the subscribed
@@ -196,7 +199,15 @@ namespace bdn
             int64_t subId = _nextSubId;
             _nextSubId++;
 
-            _subMap[subId] = Sub_(func);
+            // the slot array must not be modified while notifications are
+            // active (see notifyImpl). So in that case the new subscription
+            // is added when the last notification finishes. Note that this
+            // means that a function that is subscribed during a notification
+            // is not called by that notification.
+            if (_activeNotificationCount > 0)
+                _pendingSlots.push_back(Slot_(subId, func));
+            else
+                _slots.push_back(Slot_(subId, func));
 
             return subId;
         }
@@ -205,67 +216,105 @@ namespace bdn
         MUTEX_TYPE &getMutex() { return _mutex; }
 
       private:
-        struct Sub_
+        using FuncList_ = std::vector<std::function<void(ARG_TYPES...)>>;
+
+        /** An entry in the slot array. The subscription IDs are assigned in
+           increasing order and new slots are always appended, so the slot
+           array is sorted by subscription ID. Since IDs are never reused, the
+           ID also acts as a generation tag: a Subscription_ object can never
+           refer to a newer subscription that happens to occupy the same
+           position.*/
+        struct Slot_
         {
-            Sub_() {}
-
-            Sub_(const std::function<void(ARG_TYPES...)> &func) : func(func) {}
+            Slot_(int64_t subId, const std::function<void(ARG_TYPES...)> &func) : subId(subId), func(func) {}
 
+            int64_t subId;
+            bool removed = false;
             std::function<void(ARG_TYPES...)> func;
         };
 
-        struct NotificationState
-        {
-            NotificationState *next = nullptr;
-
-            typename Map<int64_t, Sub_>::Iterator nextItemIt;
-        };
-
         void unsubscribeById(int64_t subId)
         {
+            FuncList_ garbage;
+
             typename MUTEX_TYPE::Lock lock(_mutex);
 
-            auto it = _subMap.find(subId);
-            if (it != _subMap.end()) {
-                // notifications are only done in the main thread.
-                // But there can still be multiple notifications running, if the
-                // event loop is worked from an inner function (like a modal
-                // dialog that was created by another framwork).
-                NotificationState *state = _firstNotificationState;
-                while (state != nullptr) {
-                    if (state->nextItemIt == it)
-                        state->nextItemIt++;
-
-                    state = state->next;
-                }
+            removeSubscription(subId, garbage);
+        }
 
-                _subMap.erase(it);
+        /** Removes the subscription with the specified ID. _mutex must be
+           locked when this is called.
+
+            The function object of the subscription is moved to \c garbage.
+           The caller should destroy it after the mutex was released, since
+           its destructor might release objects that in turn access the
+           notifier.*/
+        void removeSubscription(int64_t subId, FuncList_ &garbage)
+        {
+            auto it = findSlot(_slots, subId);
+            if (it != _slots.end()) {
+                if (!it->removed) {
+                    markRemoved(*it);
+                    compactIfIdle(garbage);
+                }
+            } else {
+                it = findSlot(_pendingSlots, subId);
+                if (it != _pendingSlots.end()) {
+                    garbage.push_back(std::move(it->func));
+                    _pendingSlots.erase(it);
+                }
             }
         }
 
-        void activateNotificationState(NotificationState *state)
+        static typename std::vector<Slot_>::iterator findSlot(std::vector<Slot_> &slots, int64_t subId)
         {
-            state->next = _firstNotificationState;
-            _firstNotificationState = state;
+            auto it = std::lower_bound(slots.begin(), slots.end(), subId,
+                                       [](const Slot_ &slot, int64_t subId) { return slot.subId < subId; });
+            if (it != slots.end() && it->subId == subId)
+                return it;
+            return slots.end();
         }
 
-        void deactivateNotificationState(NotificationState *state)
+        /** Marks the slot as removed. Note that the function object stays in
+           place while notifications are active, since it might currently be
+           executing.*/
+        void markRemoved(Slot_ &slot)
         {
-            // we usually have only one notification state active
-            if (state == _firstNotificationState)
-                _firstNotificationState = state->next;
-            else {
-                NotificationState *prev = _firstNotificationState;
-                NotificationState *curr = _firstNotificationState->next;
-
-                while (curr != nullptr) {
-                    if (curr == state) {
-                        prev->next = state->next;
-                        break;
-                    }
+            slot.removed = true;
+            _removedSlotCount++;
+        }
 
-                    state = state->next;
+        /** Removes the tombstones from the slot array and adds pending
+           subscriptions, if no notification is active. _mutex must be locked
+           when this is called.*/
+        void compactIfIdle(FuncList_ &garbage)
+        {
+            if (_activeNotificationCount > 0)
+                return;
+
+            if (_removedSlotCount > 0) {
+                auto newEnd = _slots.begin();
+
+                for (auto it = _slots.begin(); it != _slots.end(); ++it) {
+                    if (it->removed)
+                        garbage.push_back(std::move(it->func));
+                    else {
+                        if (newEnd != it)
+                            *newEnd = std::move(*it);
+                        ++newEnd;
+                    }
                 }
+
+                _slots.erase(newEnd, _slots.end());
+                _removedSlotCount = 0;
+            }
+
+            if (!_pendingSlots.empty()) {
+                // pending subscriptions always have higher IDs than the
+                // existing ones, so the slot array stays sorted.
+                for (Slot_ &slot : _pendingSlots)
+                    _slots.push_back(std::move(slot));
+                _pendingSlots.clear();
             }
         }
 
@@ -293,8 +342,10 @@ namespace bdn
 
         MUTEX_TYPE _mutex;
         int64_t _nextSubId = 1;
-        Map<int64_t, Sub_> _subMap;
-        NotificationState *_firstNotificationState = nullptr;
+        std::vector<Slot_> _slots;
+        std::vector<Slot_> _pendingSlots;
+        size_t _removedSlotCount = 0;
+        int _activeNotificationCount = 0;
     };
 }
 
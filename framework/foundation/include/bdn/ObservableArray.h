@@ -0,0 +1,316 @@
+#ifndef BDN_ObservableArray_H_
+#define BDN_ObservableArray_H_
+
+#include <bdn/Array.h>
+#include <bdn/SimpleNotifier.h>
+#include <bdn/PropertyBatch.h>
+#include <bdn/ProgrammingError.h>
+
+#include <algorithm>
+
+namespace bdn
+{
+
+    /** Describes a single modification of an ObservableArray.
+
+        Change records are always meant to be applied in sequence: the
+       indices of a record refer to the state of the array after all previous
+       records of the same notification have been applied.
+
+        The records do not contain the element values. Receivers read the new
+       values directly from the array (which already contains all changes when
+       the notification is delivered). So the values of inserted and updated
+       elements have to be read after all records have been applied.*/
+    struct ArrayChange
+    {
+        enum class Type
+        {
+            /** \c count elements were inserted at \c index.*/
+            insert,
+
+            /** \c count elements were removed, starting at \c index.*/
+            remove,
+
+            /** The element at \c index was moved to \c toIndex. \c toIndex
+               refers to the position after the element was removed from its
+               old position.*/
+            move,
+
+            /** \c count elements starting at \c index were replaced with new
+               values.*/
+            update
+        };
+
+        Type type;
+        size_t index;
+        size_t count;
+        size_t toIndex;
+
+        bool operator==(const ArrayChange &o) const
+        {
+            return type == o.type && index == o.index && count == o.count && toIndex == o.toIndex;
+        }
+
+        bool operator!=(const ArrayChange &o) const { return !operator==(o); }
+    };
+
+    template <typename CHAR_TYPE, class CHAR_TRAITS>
+    std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
+                                                           const ArrayChange &change)
+    {
+        static const char *typeNames[] = {"insert", "remove", "move", "update"};
+
+        stream << "(" << typeNames[(int)change.type] << ", " << change.index << ", " << change.count;
+        if (change.type == ArrayChange::Type::move)
+            stream << " -> " << change.toIndex;
+
+        return stream << ")";
+    }
+
+    /** An array that notifies its observers about modifications with compact
+       change records (see ArrayChange).
+
+        Wrapping a collection in a normal property means that observers only
+       learn that "something" changed, and setting the property compares the
+       whole old and new collection. ObservableArray instead reports exactly
+       which ranges were inserted, removed, moved or updated. List views and
+       similar observers can use that to update incrementally.
+
+        Consecutive modifications that touch adjacent ranges are merged into a
+       single record (for example, adding many elements at the end results in
+       one insert record). Outside of a batch every modification is delivered
+       immediately, so merging only happens within a PropertyBatch: while a
+       PropertyBatch is active, the records are collected and delivered in a
+       single notification when the outermost batch ends.
+
+        The array contents can be read via getArray() and the usual accessors.
+       All modifications must be made via the methods of ObservableArray.
+
+        Like properties, ObservableArray is not thread safe.
+        ObservableArray objects MUST be allocated with newObj / new.
+    */
+    template <typename ELTYPE> class ObservableArray : public Base
+    {
+      public:
+        using Element = ELTYPE;
+        using Size = typename Array<ELTYPE>::Size;
+        using ConstIterator = typename Array<ELTYPE>::ConstIterator;
+
+        ObservableArray() {}
+
+        /** Returns the notifier that is called when the array changes. The
+           notification parameter contains the change records (see
+           ArrayChange).*/
+        ISyncNotifier<const Array<ArrayChange> &> &onChange()
+        {
+            if (_onChange == nullptr)
+                _onChange = newObj<SimpleNotifier<const Array<ArrayChange> &>>();
+
+            return *_onChange;
+        }
+
+        /** Returns a reference to the underlying array. The reference must not
+           be used to modify the array.*/
+        const Array<ELTYPE> &getArray() const { return _array; }
+
+        Size getSize() const { return _array.getSize(); }
+
+        bool isEmpty() const { return _array.isEmpty(); }
+
+        const ELTYPE &operator[](Size index) const { return _array[index]; }
+
+        ConstIterator begin() const { return _array.begin(); }
+        ConstIterator end() const { return _array.end(); }
+
+        /** Adds an element at the end.*/
+        void add(const ELTYPE &el) { insertAt(_array.size(), el); }
+
+        /** Adds an element at the end.*/
+        void add(ELTYPE &&el) { insertAt(_array.size(), std::move(el)); }
+
+        /** Inserts an element at the specified index.*/
+        void insertAt(Size index, const ELTYPE &el)
+        {
+            checkIndex(index, _array.size());
+
+            _array.insert(_array.begin() + index, el);
+            record({ArrayChange::Type::insert, index, 1, 0});
+        }
+
+        /** Inserts an element at the specified index.*/
+        void insertAt(Size index, ELTYPE &&el)
+        {
+            checkIndex(index, _array.size());
+
+            _array.insert(_array.begin() + index, std::move(el));
+            record({ArrayChange::Type::insert, index, 1, 0});
+        }
+
+        /** Inserts a sequence of elements at the specified index.*/
+        template <class InputIt> void insertSequenceAt(Size index, InputIt beginIt, InputIt endIt)
+        {
+            checkIndex(index, _array.size());
+
+            Size sizeBefore = _array.size();
+            _array.insert(_array.begin() + index, beginIt, endIt);
+
+            Size count = _array.size() - sizeBefore;
+            if (count > 0)
+                record({ArrayChange::Type::insert, index, count, 0});
+        }
+
+        /** Removes \c count elements, starting at \c index.*/
+        void removeRange(Size index, Size count)
+        {
+            if (count == 0)
+                return;
+
+            checkIndex(index + count, _array.size());
+
+            _array.erase(_array.begin() + index, _array.begin() + index + count);
+            record({ArrayChange::Type::remove, index, count, 0});
+        }
+
+        /** Removes the element at the specified index.*/
+        void removeAt(Size index) { removeRange(index, 1); }
+
+        /** Removes all elements.*/
+        void clear() { removeRange(0, _array.size()); }
+
+        /** Moves the element at \c fromIndex to \c toIndex. \c toIndex refers
+           to the position after the element was removed from its old
+           position.*/
+        void move(Size fromIndex, Size toIndex)
+        {
+            checkIndex(fromIndex + 1, _array.size());
+            checkIndex(toIndex + 1, _array.size());
+
+            if (fromIndex == toIndex)
+                return;
+
+            if (fromIndex < toIndex)
+                std::rotate(_array.begin() + fromIndex, _array.begin() + fromIndex + 1,
+                            _array.begin() + toIndex + 1);
+            else
+                std::rotate(_array.begin() + toIndex, _array.begin() + fromIndex, _array.begin() + fromIndex + 1);
+
+            record({ArrayChange::Type::move, fromIndex, 1, toIndex});
+        }
+
+        /** Replaces the element at the specified index. Nothing happens if
+           the new value is equal to the old one.*/
+        void set(Size index, const ELTYPE &el)
+        {
+            checkIndex(index + 1, _array.size());
+
+            if (_array[index] != el) {
+                _array[index] = el;
+                record({ArrayChange::Type::update, index, 1, 0});
+            }
+        }
+
+        /** Replaces the element at the specified index. Nothing happens if
+           the new value is equal to the old one.*/
+        void set(Size index, ELTYPE &&el)
+        {
+            checkIndex(index + 1, _array.size());
+
+            if (_array[index] != el) {
+                _array[index] = std::move(el);
+                record({ArrayChange::Type::update, index, 1, 0});
+            }
+        }
+
+        /** Returns the change records that have been collected in the current
+           PropertyBatch and that have not been delivered yet.*/
+        const Array<ArrayChange> &getPendingChanges() const { return _pendingChanges; }
+
+      private:
+        static void checkIndex(Size indexEnd, Size size)
+        {
+            if (indexEnd > size)
+                programmingError("ObservableArray: index out of range.");
+        }
+
+        void record(const ArrayChange &change)
+        {
+            if (!PropertyBatch::isActive()) {
+                if (_onChange != nullptr)
+                    _onChange->notify(Array<ArrayChange>({change}));
+                return;
+            }
+
+            if (_pendingChanges.isEmpty()) {
+                P<ObservableArray> self = this;
+                PropertyBatch::defer(this, 0, [self]() { self->deliverPending(); });
+            }
+
+            if (_pendingChanges.isEmpty() || !tryMerge(_pendingChanges.back(), change))
+                _pendingChanges.add(change);
+        }
+
+        /** Tries to merge \c change into the previous record \c last. Returns
+           false if the two cannot be combined.*/
+        static bool tryMerge(ArrayChange &last, const ArrayChange &change)
+        {
+            using Type = ArrayChange::Type;
+
+            if (last.type == Type::insert) {
+                if (change.type == Type::insert && change.index >= last.index &&
+                    change.index <= last.index + last.count) {
+                    // inserted into or directly next to the previously inserted
+                    // range. The result is one bigger inserted range.
+                    last.count += change.count;
+                    return true;
+                }
+
+                if (change.type == Type::update && change.index >= last.index &&
+                    change.index + change.count <= last.index + last.count) {
+                    // updating elements that were just inserted. The receiver
+                    // reads the current values anyway.
+                    return true;
+                }
+            } else if (last.type == Type::remove && change.type == Type::remove) {
+                if (change.index == last.index) {
+                    // removing forward
+                    last.count += change.count;
+                    return true;
+                }
+
+                if (change.index + change.count == last.index) {
+                    // removing backward
+                    last.index = change.index;
+                    last.count += change.count;
+                    return true;
+                }
+            } else if (last.type == Type::update && change.type == Type::update) {
+                size_t lastEnd = last.index + last.count;
+                size_t changeEnd = change.index + change.count;
+
+                if (change.index <= lastEnd && changeEnd >= last.index) {
+                    // overlapping or adjacent ranges
+                    last.index = std::min(last.index, change.index);
+                    last.count = std::max(lastEnd, changeEnd) - last.index;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void deliverPending()
+        {
+            Array<ArrayChange> changes;
+            changes.swap(_pendingChanges);
+
+            if (_onChange != nullptr && !changes.isEmpty())
+                _onChange->notify(changes);
+        }
+
+        Array<ELTYPE> _array;
+        Array<ArrayChange> _pendingChanges;
+        P<SimpleNotifier<const Array<ArrayChange> &>> _onChange;
+    };
+}
+
+#endif
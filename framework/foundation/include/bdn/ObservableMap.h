@@ -0,0 +1,199 @@
+#ifndef BDN_ObservableMap_H_
+#define BDN_ObservableMap_H_
+
+#include <bdn/Map.h>
+#include <bdn/Array.h>
+#include <bdn/SimpleNotifier.h>
+#include <bdn/PropertyBatch.h>
+
+namespace bdn
+{
+
+    /** Describes a single modification of an ObservableMap (see there).*/
+    template <typename KEYTYPE> struct MapChange
+    {
+        enum class Type
+        {
+            /** An entry with the key was added.*/
+            insert,
+
+            /** The entry with the key was removed.*/
+            remove,
+
+            /** The value of the entry with the key was replaced.*/
+            update
+        };
+
+        Type type;
+        KEYTYPE key;
+
+        bool operator==(const MapChange &o) const { return type == o.type && key == o.key; }
+        bool operator!=(const MapChange &o) const { return !operator==(o); }
+    };
+
+    template <typename CHAR_TYPE, class CHAR_TRAITS, typename KEYTYPE>
+    std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
+                                                           const MapChange<KEYTYPE> &change)
+    {
+        static const char *typeNames[] = {"insert", "remove", "update"};
+
+        return stream << "(" << typeNames[(int)change.type] << ", " << change.key << ")";
+    }
+
+    /** A map that notifies its observers about modifications with one change
+       record per modified key (see MapChange).
+
+        Outside of a batch every modification is delivered immediately. While
+       a PropertyBatch is active, the records are collected and delivered in a
+       single notification when the outermost batch ends. Within a batch there
+       is at most one record per key - multiple modifications of the same key
+       are combined (for example, an insert followed by an update is reported
+       as an insert, and an insert followed by a remove is not reported at
+       all). The records are in the order in which the keys were first
+       modified.
+
+        The records do not contain the values. Receivers read the current
+       values from the map.
+
+        Like properties, ObservableMap is not thread safe.
+        ObservableMap objects MUST be allocated with newObj / new.
+    */
+    template <typename KEYTYPE, typename VALTYPE> class ObservableMap : public Base
+    {
+      public:
+        using Change = MapChange<KEYTYPE>;
+        using Size = typename Map<KEYTYPE, VALTYPE>::Size;
+        using ConstIterator = typename Map<KEYTYPE, VALTYPE>::ConstIterator;
+
+        ObservableMap() {}
+
+        /** Returns the notifier that is called when the map changes.*/
+        ISyncNotifier<const Array<Change> &> &onChange()
+        {
+            if (_onChange == nullptr)
+                _onChange = newObj<SimpleNotifier<const Array<Change> &>>();
+
+            return *_onChange;
+        }
+
+        /** Returns a reference to the underlying map. The reference must not
+           be used to modify the map.*/
+        const Map<KEYTYPE, VALTYPE> &getMap() const { return _map; }
+
+        Size getSize() const { return _map.getSize(); }
+
+        bool isEmpty() const { return _map.isEmpty(); }
+
+        bool contains(const KEYTYPE &key) const { return _map.contains(key); }
+
+        /** Returns a pointer to the value for the specified key, or null if
+           the map does not contain the key.*/
+        const VALTYPE *find(const KEYTYPE &key) const
+        {
+            auto it = _map.find(key);
+            return (it == _map.end()) ? nullptr : &it->second;
+        }
+
+        ConstIterator begin() const { return _map.begin(); }
+        ConstIterator end() const { return _map.end(); }
+
+        /** Sets the value for the specified key. Inserts a new entry if the key
+           does not exist yet. Nothing happens if the key exists and the new
+           value is equal to the old one.*/
+        void set(const KEYTYPE &key, const VALTYPE &value)
+        {
+            auto it = _map.find(key);
+            if (it == _map.end()) {
+                _map.add(key, value);
+                record(Change::Type::insert, key);
+            } else if (it->second != value) {
+                it->second = value;
+                record(Change::Type::update, key);
+            }
+        }
+
+        /** Removes the entry with the specified key. Does nothing if the key
+           does not exist.*/
+        void remove(const KEYTYPE &key)
+        {
+            auto it = _map.find(key);
+            if (it != _map.end()) {
+                _map.erase(it);
+                record(Change::Type::remove, key);
+            }
+        }
+
+        /** Removes all entries.*/
+        void clear()
+        {
+            Map<KEYTYPE, VALTYPE> oldMap;
+            oldMap.swap(_map);
+
+            for (auto &entry : oldMap)
+                record(Change::Type::remove, entry.first);
+        }
+
+        /** Returns the number of keys that have been modified in the current
+           PropertyBatch and whose changes have not been delivered yet.*/
+        size_t getPendingChangeCount() const { return _pendingKeys.size(); }
+
+      private:
+        void record(typename Change::Type type, const KEYTYPE &key)
+        {
+            if (!PropertyBatch::isActive()) {
+                if (_onChange != nullptr)
+                    _onChange->notify(Array<Change>({Change{type, key}}));
+                return;
+            }
+
+            if (_pendingKeys.isEmpty()) {
+                P<ObservableMap> self = this;
+                PropertyBatch::defer(this, 0, [self]() { self->deliverPending(); });
+            }
+
+            // we only need to remember whether the key existed before its first
+            // modification in the batch. The resulting change is derived from
+            // that and the final state when the batch ends.
+            if (!_pendingExistedBefore.contains(key)) {
+                _pendingExistedBefore.add(key, type != Change::Type::insert);
+                _pendingKeys.add(key);
+            }
+        }
+
+        void deliverPending()
+        {
+            Array<KEYTYPE> keys;
+            keys.swap(_pendingKeys);
+
+            Map<KEYTYPE, bool> existedBefore;
+            existedBefore.swap(_pendingExistedBefore);
+
+            Array<Change> changes;
+            changes.reserve(keys.size());
+
+            for (auto &key : keys) {
+                bool before = existedBefore[key];
+                bool now = _map.contains(key);
+
+                // a key that was inserted and removed again within the batch
+                // never existed from the receiver's point of view.
+                if (before && now)
+                    changes.add(Change{Change::Type::update, key});
+                else if (before)
+                    changes.add(Change{Change::Type::remove, key});
+                else if (now)
+                    changes.add(Change{Change::Type::insert, key});
+            }
+
+            if (_onChange != nullptr && !changes.isEmpty())
+                _onChange->notify(changes);
+        }
+
+        Map<KEYTYPE, VALTYPE> _map;
+        Array<KEYTYPE> _pendingKeys;
+        Map<KEYTYPE, bool> _pendingExistedBefore;
+        P<SimpleNotifier<const Array<Change> &>> _onChange;
+    };
+}
+
+#endif
@@ -3,8 +3,14 @@
 
 #include <bdn/IAsyncNotifier.h>
 #include <bdn/RequireNewAlloc.h>
+#include <bdn/DanglingFunctionError.h>
 #include <bdn/mainThread.h>
 
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 namespace bdn
 {
 
@@ -59,6 +65,25 @@ namespace bdn
        have to use a pointer as the Notifier template parameter (and as such,
        the subscribed functions will get such a pointer as their parameter).
 
+        Late subscribers
+        ----------------
+
+        By default, late subscribers are called from the main thread (see
+       LateSubscriberCall::postToMainThread). That costs a round trip through
+       the main dispatcher, and consumers that run in background threads are
+       bounced to the main thread. The constructor can select a different
+       mode:
+
+        - LateSubscriberCall::callInline: late subscribers are called
+       immediately from the thread that subscribes them, before the subscribe
+       function returns. Note that subscribers that are added while the
+       initial notification is still pending are simply called together with
+       the initial subscribers.
+
+        - LateSubscriberCall::postToDispatcher: all notification calls (the
+       initial one and those for late subscribers) are posted to the dispatcher
+       that is passed to the constructor instead of the main dispatcher.
+
     */
     template <class... ArgTypes>
     class OneShotStateNotifier :
@@ -68,8 +93,35 @@ namespace bdn
         BDN_IMPLEMENTS IAsyncNotifier<ArgTypes...>
     {
       public:
+        /** Controls how subscribers that are added after the notification
+         * are called (see class documentation).*/
+        enum class LateSubscriberCall
+        {
+            postToMainThread,
+            callInline,
+            postToDispatcher
+        };
+
         OneShotStateNotifier() {}
 
+        /** \param lateSubscriberCall controls how late subscribers are called.
+            \param dispatcher the dispatcher to use with
+           LateSubscriberCall::postToDispatcher. Must be null for the other
+           modes.*/
+        OneShotStateNotifier(LateSubscriberCall lateSubscriberCall, IDispatcher *dispatcher = nullptr)
+            : _lateSubscriberCall(lateSubscriberCall), _dispatcher(dispatcher)
+        {
+            if ((lateSubscriberCall == LateSubscriberCall::postToDispatcher) != (dispatcher != nullptr))
+                programmingError("OneShotStateNotifier: a dispatcher must be specified if and only if "
+                                 "LateSubscriberCall::postToDispatcher is used.");
+        }
+
+        ~OneShotStateNotifier()
+        {
+            if (_postNotificationCalled)
+                args().~ArgTuple_();
+        }
+
         P<INotifierSubscription> subscribe(const std::function<void(ArgTypes...)> &func) override
         {
             int64_t subId = subscribeInternal(func);
@@ -99,12 +151,12 @@ namespace bdn
                                  "times. It should only be done once.");
             }
 
-            _postNotificationCalled = true;
+            // store a copy of the arguments, so that we can call newly added
+            // functions when they subscribe. The tuple lives inside the
+            // notifier object - no additional allocation is needed.
+            new (&_argStorage) ArgTuple_(args...);
 
-            // bind the arguments to our static function callFuncWithParams, so
-            // that we can call newly added functions when they subscribe
-            _subscribedFuncCaller =
-                std::bind(&OneShotStateNotifier::callFuncWithParams, std::placeholders::_1, args...);
+            _postNotificationCalled = true;
 
             scheduleNotifyCall();
         }
@@ -122,15 +174,45 @@ namespace bdn
         }
 
       private:
-        static void callFuncWithParams(const std::function<void(ArgTypes...)> &func, ArgTypes... args)
+        using ArgTuple_ = std::tuple<typename std::decay<ArgTypes>::type...>;
+
+        ArgTuple_ &args() { return *reinterpret_cast<ArgTuple_ *>(&_argStorage); }
+
+        void callWithArgs(const std::function<void(ArgTypes...)> &func)
+        {
+            callWithArgs(func, std::index_sequence_for<ArgTypes...>());
+        }
+
+        template <size_t... INDICES>
+        void callWithArgs(const std::function<void(ArgTypes...)> &func, std::index_sequence<INDICES...>)
         {
-            func(args...);
+            func(std::get<INDICES>(args())...);
         }
 
         int64_t subscribeInternal(const std::function<void(ArgTypes...)> &func)
         {
             Mutex::Lock lock(_mutex);
 
+            if (_postNotificationCalled && !_notificationPending &&
+                _lateSubscriberCall == LateSubscriberCall::callInline) {
+                // the notification is complete and the arguments will not
+                // change anymore. So we can call the function right here,
+                // without the mutex and without storing it.
+                Mutex::Unlock unlock(_mutex);
+
+                try {
+                    callWithArgs(func);
+                }
+                catch (DanglingFunctionError &) {
+                    // the target object has already been destroyed. That is
+                    // not an error.
+                }
+
+                // the returned subscription does not refer to an existing
+                // subscriber. Unsubscribing it has no effect.
+                return 0;
+            }
+
             // always add the subscriber to the map. If postNotification has
             // already been called then it is still correct (see below)
 
@@ -183,7 +265,11 @@ namespace bdn
         void scheduleNotifyCall()
         {
             _notificationPending = true;
-            asyncCallFromMainThread(strongMethod(this, &OneShotStateNotifier::doNotify));
+
+            if (_dispatcher != nullptr)
+                _dispatcher->enqueue(strongMethod(this, &OneShotStateNotifier::doNotify));
+            else
+                asyncCallFromMainThread(strongMethod(this, &OneShotStateNotifier::doNotify));
         }
 
         struct Sub_
@@ -260,10 +346,10 @@ namespace bdn
                     try {
                         Mutex::Unlock unlock(_mutex);
 
-                        // note that _subscribedFuncCaller has the notification
-                        // parameters bound to it. So we do not need to pass
-                        // them here.
-                        _subscribedFuncCaller(item.second.func);
+                        // note that the arguments are never modified after
+                        // postNotification, so we can access them without the
+                        // mutex.
+                        callWithArgs(item.second.func);
                     }
                     catch (DanglingFunctionError &) {
                         // this is a perfectly normal case. It means that the
@@ -320,7 +406,12 @@ namespace bdn
         bool _postNotificationCalled = false;
         bool _notificationPending = false;
         NotificationState *_notificationState = nullptr;
-        std::function<void(const std::function<void(ArgTypes...)> &)> _subscribedFuncCaller;
+
+        LateSubscriberCall _lateSubscriberCall = LateSubscriberCall::postToMainThread;
+        P<IDispatcher> _dispatcher;
+
+        // holds an ArgTuple_ object after postNotification was called.
+        typename std::aligned_storage<sizeof(ArgTuple_), alignof(ArgTuple_)>::type _argStorage;
     };
 }
 
@@ -3,6 +3,8 @@
 
 #include <bdn/IPropertyReadAccessor.h>
 
+#include <type_traits>
+
 namespace bdn
 {
 
@@ -46,6 +48,14 @@ namespace bdn
 
         VALUE_TYPE get() const override { return (_owner->*_getterMethod)(); }
 
+        /** Returns a pointer to the property value if the getter returns a
+           reference to it (see IPropertyReadAccessor::getValuePointer()).*/
+        const VALUE_TYPE *getValuePointer() const override
+        {
+            return getValuePointerImpl(
+                typename std::is_same<decltype((_owner->*_getterMethod)()), const VALUE_TYPE &>::type());
+        }
+
         IPropertyNotifier<VALUE_TYPE> &changed() const override { return (_owner->*_changedMethod)(); }
 
       protected:
@@ -53,6 +63,10 @@ namespace bdn
         OWNER_TYPE *getOwner() const { return _owner; }
 
       private:
+        const VALUE_TYPE *getValuePointerImpl(std::true_type) const { return &(_owner->*_getterMethod)(); }
+
+        const VALUE_TYPE *getValuePointerImpl(std::false_type) const { return nullptr; }
+
         OWNER_TYPE *_owner;
         GETTER_METHOD_TYPE _getterMethod;
         CHANGED_METHOD_TYPE _changedMethod;
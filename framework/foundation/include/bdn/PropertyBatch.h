@@ -0,0 +1,99 @@
+#ifndef BDN_PropertyBatch_H_
+#define BDN_PropertyBatch_H_
+
+#include <bdn/safeStatic.h>
+
+#include <functional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Groups a set of property modifications into a single transaction.
+
+        While a PropertyBatch object exists on the current thread, property
+       change notifications (see \ref BDN_NOTIFY_PROPERTY_CHANGED) and the
+       layout influences of view properties (see \ref BDN_VIEW_PROPERTY) are
+       not executed immediately. Instead they are queued and executed when the
+       outermost PropertyBatch object is destroyed.
+
+        Repeated changes of the same property only result in a single
+       notification. Since notifications always provide the current value of
+       the property, subscribers get the final value. The same applies to
+       layout influences: if many properties of a view invalidate its sizing
+       info then the sizing info is only invalidated once.
+
+        The queued actions are executed in the order in which they were first
+       queued.
+
+        \code
+
+        {
+            PropertyBatch batch;
+
+            view->setMargin( UiMargin(10) );
+            view->setPadding( UiMargin(5) );
+            view->setHorizontalAlignment( View::HorizontalAlignment::center );
+
+            // nothing has been notified or invalidated yet
+        }
+
+        // now all notifications have been delivered and the view was
+        // invalidated once.
+
+        \endcode
+
+        Batches can be nested. Only the outermost batch delivers the queued
+       actions.
+
+        Exceptions that are thrown by the queued actions cannot propagate out
+       of the PropertyBatch destructor. They are logged and ignored, and the
+       remaining actions are still executed.
+
+        PropertyBatch is thread local. Modifications that are made on another
+       thread are not affected. PropertyBatch objects must be created on the
+       stack.
+    */
+    class PropertyBatch
+    {
+      public:
+        PropertyBatch();
+        ~PropertyBatch();
+
+        PropertyBatch(const PropertyBatch &) = delete;
+        PropertyBatch &operator=(const PropertyBatch &) = delete;
+
+        /** Returns true if a PropertyBatch is active on the calling thread.*/
+        static bool isActive() { return getState().depth > 0; }
+
+        /** Queues an action for execution at the end of the outermost batch.
+
+            The action is identified by the target object and an action code
+           (for example, a notifier object and a constant that identifies the
+           notification). If an action with the same identification is already
+           queued then the new action is ignored.
+
+            Must only be called while a batch is active (see isActive()).*/
+        static void defer(const void *target, int actionCode, std::function<void()> action);
+
+        /** Returns the number of queued actions of the calling thread.*/
+        static size_t getPendingCount() { return getState().pending.size(); }
+
+      private:
+
+        struct State
+        {
+            int depth = 0;
+            std::vector<std::function<void()>> pending;
+            std::set<std::pair<const void *, int>> pendingKeys;
+        };
+
+        static BDN_SAFE_STATIC_THREAD_LOCAL(State, getState);
+
+        static void deliver(State &state);
+    };
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef BDN_PropertyNotificationPhase_H_
+#define BDN_PropertyNotificationPhase_H_
+
+#include <bdn/safeStatic.h>
+
+#include <functional>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Keeps track of the property change notifications that are currently
+       running on the calling thread.
+
+        A property change often causes a cascade of further notifications
+       (subscribers set other properties, and so on). Some actions should only
+       happen once the whole cascade has finished - for example, a
+       ComputedProperty should only recompute its value after all of its
+       dependencies have been informed about the change. Otherwise it might
+       combine an updated value with one that is about to change.
+
+        PropertyNotifier calls enter() before it calls its subscribers and
+       leave() afterwards. Actions that are passed to defer() are executed when
+       the outermost notification of the thread has finished.
+
+        All state is thread local, so PropertyNotificationPhase does not need
+       any synchronization.
+    */
+    class PropertyNotificationPhase
+    {
+      public:
+        /** Called by PropertyNotifier before it calls its subscribers.*/
+        static void enter() { getState().depth++; }
+
+        /** Called by PropertyNotifier after its subscribers have been called.
+           If this ends the outermost notification of the thread then the
+           deferred actions are executed. Exceptions thrown by deferred actions
+           are propagated to the caller.*/
+        static void leave()
+        {
+            State &state = getState();
+
+            state.depth--;
+            if (state.depth == 0 && !state.deferred.empty())
+                runDeferred(state);
+        }
+
+        /** Like leave(), but for the case that a subscriber has thrown an
+           exception. The deferred actions are not executed in this case. They
+           remain queued and are executed when the next outermost notification
+           finishes.*/
+        static void leaveAfterException() { getState().depth--; }
+
+        /** Returns true if a property change notification is currently running
+           on the calling thread.*/
+        static bool isActive() { return getState().depth > 0; }
+
+        /** Schedules \c action to be executed when the outermost property
+           change notification of the calling thread has finished. If no
+           notification is running then \c action is executed immediately.
+
+            Deferred actions are executed in the order in which they were
+           added. Notifications caused by a deferred action are part of the same
+           phase, so actions that they defer are executed in the same loop.*/
+        static void defer(std::function<void()> action);
+
+      private:
+        struct State
+        {
+            int depth = 0;
+            std::vector<std::function<void()>> deferred;
+        };
+
+        static BDN_SAFE_STATIC_THREAD_LOCAL(State, getState);
+
+        static void runDeferred(State &state);
+    };
+}
+
+#endif
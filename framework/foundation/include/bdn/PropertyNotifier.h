@@ -4,6 +4,7 @@
 #include <bdn/DummyMutex.h>
 #include <bdn/IPropertyNotifier.h>
 #include <bdn/NotifierBase.h>
+#include <bdn/PropertyNotificationPhase.h>
 
 namespace bdn
 {
@@ -28,9 +29,21 @@ namespace bdn
 
         void notify(const IPropertyReadAccessor<PROPERTY_VALUE_TYPE> &propertyAccessor) override
         {
-            BASE::template notifyImpl<decltype(&PropertyNotifier::callPropertySubscriber),
-                                      const IPropertyReadAccessor<PROPERTY_VALUE_TYPE> &>(
-                &PropertyNotifier::callPropertySubscriber, propertyAccessor);
+            // see PropertyNotificationPhase. This allows actions to be
+            // deferred until the whole notification cascade has finished.
+            PropertyNotificationPhase::enter();
+
+            try {
+                BASE::template notifyImpl<decltype(&PropertyNotifier::callPropertySubscriber),
+                                          const IPropertyReadAccessor<PROPERTY_VALUE_TYPE> &>(
+                    &PropertyNotifier::callPropertySubscriber, propertyAccessor);
+            }
+            catch (...) {
+                PropertyNotificationPhase::leaveAfterException();
+                throw;
+            }
+
+            PropertyNotificationPhase::leave();
         }
 
       private:
@@ -41,7 +54,14 @@ namespace bdn
         static void callPropertySubscriber(const std::function<void(const PROPERTY_VALUE_TYPE &)> &subscribedFunc,
                                            const IPropertyReadAccessor<PROPERTY_VALUE_TYPE> &propertyAccessor)
         {
-            subscribedFunc(propertyAccessor.get());
+            // if the property provides a reference to its stored value then we
+            // pass that on. That avoids a copy of the value for each
+            // subscriber.
+            const PROPERTY_VALUE_TYPE *valuePointer = propertyAccessor.getValuePointer();
+            if (valuePointer != nullptr)
+                subscribedFunc(*valuePointer);
+            else
+                subscribedFunc(propertyAccessor.get());
         }
     };
 }
@@ -0,0 +1,79 @@
+#ifndef BDN_PropertyNotifierTable_H_
+#define BDN_PropertyNotifierTable_H_
+
+#include <bdn/PropertyNotifier.h>
+
+#include <vector>
+
+namespace bdn
+{
+
+    /** Stores the "changed" notifiers of all properties of an object (see
+       \ref BDN_PROPERTY and \ref BDN_PROPERTY_CHANGED_DEFAULT_IMPLEMENTATION).
+
+        Most property notifiers are never subscribed to. So instead of having
+       one notifier member per property, each object has a single pointer to
+       a PropertyNotifierTable (see Base::_getPropertyNotifierTable()). The
+       table is only allocated when the first notifier of the object is
+       requested, and a notifier is only created when its "changed" function
+       is called. Until then, notifying a property change only costs a null
+       pointer check.
+
+        The table is a small vector that is searched linearly. Objects usually
+       only have a handful of properties that are actually subscribed to, so
+       that is faster and more compact than a map.
+
+        Like PropertyNotifier, PropertyNotifierTable is not thread safe.
+    */
+    class PropertyNotifierTable
+    {
+      public:
+        /** Returns the notifier for the specified property of the owner
+           object. If the notifier does not exist yet then it is created.
+
+            propertyName must point to a static string (usually a string
+           literal).*/
+        template <class VALUE_TYPE>
+        static PropertyNotifier<VALUE_TYPE> &getOrCreate(const Base *owner, const char *propertyName)
+        {
+            PropertyNotifierTable *table = owner->_getPropertyNotifierTable(true);
+
+            Base *notifier = table->findNotifier(propertyName);
+            if (notifier != nullptr)
+                return *static_cast<PropertyNotifier<VALUE_TYPE> *>(notifier);
+
+            P<PropertyNotifier<VALUE_TYPE>> newNotifier = newObj<PropertyNotifier<VALUE_TYPE>>();
+            table->_entries.push_back(Entry{propertyName, newNotifier});
+
+            return *newNotifier;
+        }
+
+        /** Returns the notifier for the specified property of the owner
+           object, or null if it has not been created yet.*/
+        template <class VALUE_TYPE>
+        static PropertyNotifier<VALUE_TYPE> *find(const Base *owner, const char *propertyName)
+        {
+            PropertyNotifierTable *table = owner->_getPropertyNotifierTable(false);
+            if (table == nullptr)
+                return nullptr;
+
+            return static_cast<PropertyNotifier<VALUE_TYPE> *>(table->findNotifier(propertyName));
+        }
+
+        /** Returns the number of notifiers in the table.*/
+        size_t size() const { return _entries.size(); }
+
+      private:
+        Base *findNotifier(const char *propertyName) const;
+
+        struct Entry
+        {
+            const char *propertyName;
+            P<Base> notifier;
+        };
+
+        std::vector<Entry> _entries;
+    };
+}
+
+#endif
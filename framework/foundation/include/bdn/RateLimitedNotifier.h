@@ -0,0 +1,292 @@
+#ifndef BDN_RateLimitedNotifier_H_
+#define BDN_RateLimitedNotifier_H_
+
+#include <bdn/NotifierBase.h>
+#include <bdn/FastMutex.h>
+#include <bdn/IDispatcher.h>
+#include <bdn/RequireNewAlloc.h>
+#include <bdn/func.h>
+
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace bdn
+{
+
+    /** A notifier that forwards the notifications of one or more source
+       notifiers to its own subscribers at a limited rate.
+
+        Subscribers of the RateLimitedNotifier are called from a dispatcher
+       (the main dispatcher by default), no matter which thread the source
+       notification came from. Only the arguments of the most recent source
+       notification are delivered - intermediate values are dropped.
+
+        See Mode for the supported strategies. The functions throttle(),
+       debounce() and sampleOnIdle() are convenient shortcuts for creating an
+       adapter for a single source.
+
+        The source notifiers do not keep the RateLimitedNotifier alive. The
+       caller has to keep a reference to it for as long as notifications should
+       be delivered. Pending deliveries keep the object alive until they are
+       executed, though.
+
+        RateLimitedNotifier is thread safe. RateLimitedNotifier objects MUST be
+       allocated with newObj / new.
+    */
+    template <class... ARG_TYPES>
+    class RateLimitedNotifier
+        : public RequireNewAlloc<NotifierBase<FastMutex, ARG_TYPES...>, RateLimitedNotifier<ARG_TYPES...>>
+    {
+      private:
+        using BASE = NotifierBase<FastMutex, ARG_TYPES...>;
+
+      public:
+        enum class Mode
+        {
+            /** The first notification is delivered as soon as possible.
+               After that, at most one notification is delivered per interval.
+               The last notification of a burst is always delivered (at the end
+               of the interval in which it happened).*/
+            throttle,
+
+            /** Notifications are only delivered after the source has been quiet
+               for at least the interval. A continuous stream of source
+               notifications delays the delivery until the stream stops.
+
+                To avoid one dispatcher item per source notification, the quiet
+               period is checked with a single pending timer. So the delivery
+               happens between one and two intervals after the last source
+               notification.*/
+            debounce,
+
+            /** Notifications are delivered with idle priority (see
+               IDispatcher::Priority::idle). So subscribers only run when the
+               dispatcher has nothing more important to do, and all source
+               notifications that happen until then are collapsed into one. The
+               interval is ignored.*/
+            sampleOnIdle
+        };
+
+        /** Constructor. If dispatcher is null then the main dispatcher is
+           used.*/
+        RateLimitedNotifier(Mode mode, double intervalSeconds, IDispatcher *dispatcher = nullptr)
+            : _mode(mode), _intervalSeconds(intervalSeconds), _dispatcher(dispatcher)
+        {
+            if (_dispatcher == nullptr)
+                _dispatcher = getMainDispatcher();
+        }
+
+        Mode getMode() const { return _mode; }
+
+        double getIntervalSeconds() const { return _intervalSeconds; }
+
+        /** Subscribes the RateLimitedNotifier to the specified source notifier.
+           Can be called multiple times to combine several sources.
+
+            The subscription is a weak method, so it is removed automatically
+           from the source when the RateLimitedNotifier is destroyed.*/
+        void attachTo(INotifierBase<ARG_TYPES...> &source)
+        {
+            source.subscribe(weakMethod(this, &RateLimitedNotifier::sourceNotified));
+        }
+
+      private:
+        using ArgsTuple = std::tuple<typename std::decay<ARG_TYPES>::type...>;
+        using IndexSequence = std::index_sequence_for<ARG_TYPES...>;
+
+        void sourceNotified(ARG_TYPES... args)
+        {
+            bool startDelivery = false;
+
+            {
+                FastMutex::Lock lock(_mutex);
+
+                if (_pendingArgs == nullptr)
+                    _pendingArgs = std::make_unique<ArgsTuple>(args...);
+                else
+                    *_pendingArgs = ArgsTuple(args...);
+
+                _sourceNotificationCount++;
+
+                // if a delivery or a timer is already pending then it will
+                // pick up the new arguments.
+                if (!_deliveryActive) {
+                    _deliveryActive = true;
+                    startDelivery = true;
+                }
+            }
+
+            // note that we schedule outside the lock, so that we never hold
+            // our mutex and the dispatcher mutex at the same time.
+            if (startDelivery) {
+                P<RateLimitedNotifier> self = this;
+
+                switch (_mode) {
+                case Mode::throttle:
+                    _dispatcher->enqueue([self]() { self->deliverThrottled(); });
+                    break;
+
+                case Mode::debounce:
+                    scheduleDebounceCheck();
+                    break;
+
+                case Mode::sampleOnIdle:
+                    _dispatcher->enqueue([self]() { self->deliverSample(); }, IDispatcher::Priority::idle);
+                    break;
+                }
+            }
+        }
+
+        void deliverThrottled()
+        {
+            std::unique_ptr<ArgsTuple> args;
+
+            {
+                FastMutex::Lock lock(_mutex);
+
+                args = std::move(_pendingArgs);
+
+                // if nothing happened during the last interval then we stop.
+                // The next source notification is delivered immediately again.
+                if (args == nullptr) {
+                    _deliveryActive = false;
+                    return;
+                }
+            }
+
+            // nothing may be delivered before the interval has elapsed.
+            P<RateLimitedNotifier> self = this;
+            _dispatcher->enqueueInSeconds(_intervalSeconds, [self]() { self->deliverThrottled(); });
+
+            notifyWithTuple(*args, IndexSequence());
+        }
+
+        void scheduleDebounceCheck()
+        {
+            int64_t expectedCount;
+
+            {
+                FastMutex::Lock lock(_mutex);
+                expectedCount = _sourceNotificationCount;
+            }
+
+            P<RateLimitedNotifier> self = this;
+            _dispatcher->enqueueInSeconds(_intervalSeconds,
+                                          [self, expectedCount]() { self->checkDebounce(expectedCount); });
+        }
+
+        void checkDebounce(int64_t expectedCount)
+        {
+            std::unique_ptr<ArgsTuple> args;
+
+            {
+                FastMutex::Lock lock(_mutex);
+
+                if (_sourceNotificationCount == expectedCount) {
+                    // the source has been quiet for a full interval.
+                    args = std::move(_pendingArgs);
+                    _deliveryActive = false;
+                }
+            }
+
+            if (args == nullptr)
+                scheduleDebounceCheck();
+            else
+                notifyWithTuple(*args, IndexSequence());
+        }
+
+        void deliverSample()
+        {
+            std::unique_ptr<ArgsTuple> args;
+
+            {
+                FastMutex::Lock lock(_mutex);
+
+                args = std::move(_pendingArgs);
+                _deliveryActive = false;
+            }
+
+            if (args != nullptr)
+                notifyWithTuple(*args, IndexSequence());
+        }
+
+        template <size_t... INDICES> void notifyWithTuple(ArgsTuple &args, std::index_sequence<INDICES...>)
+        {
+            BASE::doNotify(std::get<INDICES>(args)...);
+        }
+
+        Mode _mode;
+        double _intervalSeconds;
+        P<IDispatcher> _dispatcher;
+
+        FastMutex _mutex;
+        std::unique_ptr<ArgsTuple> _pendingArgs;
+        int64_t _sourceNotificationCount = 0;
+        bool _deliveryActive = false;
+    };
+
+    /** Returns a notifier that forwards the notifications of \c source at most
+       once per interval (see RateLimitedNotifier::Mode::throttle).
+
+        The returned notifier must be kept alive by the caller. Its subscribers
+       are called from the specified dispatcher (the main dispatcher if
+       dispatcher is null).
+
+        Example:
+
+        \code
+
+        // update the expensive preview at most 10 times per second
+        _previewSizeNotifier = throttle(view->sizeChanged(), 0.1);
+        _previewSizeNotifier->subscribe(weakMethod(this, &MyClass::updatePreview));
+
+        \endcode
+    */
+    template <class... ARG_TYPES>
+    P<INotifierBase<ARG_TYPES...>> throttle(INotifierBase<ARG_TYPES...> &source, double intervalSeconds,
+                                            IDispatcher *dispatcher = nullptr)
+    {
+        P<RateLimitedNotifier<ARG_TYPES...>> notifier = newObj<RateLimitedNotifier<ARG_TYPES...>>(
+            RateLimitedNotifier<ARG_TYPES...>::Mode::throttle, intervalSeconds, dispatcher);
+        notifier->attachTo(source);
+
+        return notifier;
+    }
+
+    /** Returns a notifier that forwards the last notification of \c source
+       after the source has been quiet for the specified time (see
+       RateLimitedNotifier::Mode::debounce).
+
+        The returned notifier must be kept alive by the caller. Its subscribers
+       are called from the specified dispatcher (the main dispatcher if
+       dispatcher is null).*/
+    template <class... ARG_TYPES>
+    P<INotifierBase<ARG_TYPES...>> debounce(INotifierBase<ARG_TYPES...> &source, double quietSeconds,
+                                            IDispatcher *dispatcher = nullptr)
+    {
+        P<RateLimitedNotifier<ARG_TYPES...>> notifier = newObj<RateLimitedNotifier<ARG_TYPES...>>(
+            RateLimitedNotifier<ARG_TYPES...>::Mode::debounce, quietSeconds, dispatcher);
+        notifier->attachTo(source);
+
+        return notifier;
+    }
+
+    /** Returns a notifier that forwards the notifications of \c source when the
+       dispatcher is idle (see RateLimitedNotifier::Mode::sampleOnIdle).
+
+        The returned notifier must be kept alive by the caller. Its subscribers
+       are called from the specified dispatcher (the main dispatcher if
+       dispatcher is null).*/
+    template <class... ARG_TYPES>
+    P<INotifierBase<ARG_TYPES...>> sampleOnIdle(INotifierBase<ARG_TYPES...> &source, IDispatcher *dispatcher = nullptr)
+    {
+        P<RateLimitedNotifier<ARG_TYPES...>> notifier = newObj<RateLimitedNotifier<ARG_TYPES...>>(
+            RateLimitedNotifier<ARG_TYPES...>::Mode::sampleOnIdle, 0, dispatcher);
+        notifier->attachTo(source);
+
+        return notifier;
+    }
+}
+
+#endif
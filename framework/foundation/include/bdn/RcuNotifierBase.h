@@ -0,0 +1,296 @@
+#ifndef BDN_RcuNotifierBase_H_
+#define BDN_RcuNotifierBase_H_
+
+#include <bdn/IAsyncNotifier.h>
+#include <bdn/ISyncNotifier.h>
+#include <bdn/DanglingFunctionError.h>
+#include <bdn/FastMutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Base class for thread safe notifiers that are notified much more often
+       than their subscriptions change.
+
+        RcuNotifierBase uses a read-copy-update scheme: the subscribers are
+       stored in an immutable snapshot. Notification calls read the current
+       snapshot without taking any lock. Subscribe and unsubscribe create a new
+       snapshot and publish it atomically. So concurrent notifications from
+       multiple threads do not block each other.
+
+        Snapshots that have been replaced are reclaimed when no notification
+       is running anymore (a simple form of epoch based reclamation). If
+       notifications overlap continuously then reclamation is delayed until
+       the next quiet moment. Since subscription changes are rare, the number
+       of retired snapshots stays small.
+
+        The snapshot only contains pointers to the subscription entries. The
+       subscribed function objects are never copied.
+
+        The guarantees are the same as those of NotifierBase: a subscriber that
+       is unsubscribed is not called by notifications that have not reached it
+       yet (even if they are already running). A subscriber whose call has
+       already started cannot be stopped, of course.
+    */
+    template <class... ARG_TYPES> class RcuNotifierBase : public Base, BDN_IMPLEMENTS INotifierBase<ARG_TYPES...>
+    {
+      public:
+        RcuNotifierBase() {}
+
+        ~RcuNotifierBase()
+        {
+            // no notification can be running anymore (they keep a reference
+            // to us).
+            delete _snapshot.load();
+
+            for (Snapshot_ *snapshot : _retiredSnapshots)
+                delete snapshot;
+        }
+
+        P<INotifierSubscription> subscribe(const std::function<void(ARG_TYPES...)> &func) override
+        {
+            int64_t subId = doSubscribe(func);
+
+            return newObj<Subscription_>(subId);
+        }
+
+        INotifierBase<ARG_TYPES...> &operator+=(const std::function<void(ARG_TYPES...)> &func) override
+        {
+            doSubscribe(func);
+
+            return *this;
+        }
+
+        P<INotifierSubscription> subscribeParamless(const std::function<void()> &func) override
+        {
+            return subscribe(ParamlessFunctionAdapter(func));
+        }
+
+        void unsubscribe(INotifierSubscription *sub) override { unsubscribeById(cast<Subscription_>(sub)->subId()); }
+
+        void unsubscribeAll() override
+        {
+            {
+                FastMutex::Lock lock(_writeMutex);
+
+                Snapshot_ *oldSnapshot = _snapshot.load();
+                if (oldSnapshot == nullptr)
+                    return;
+
+                for (auto &entry : oldSnapshot->entries)
+                    entry->removed = true;
+
+                publish(nullptr);
+            }
+
+            reclaimIfIdle();
+        }
+
+      protected:
+        /** Calls all subscribers with the specified arguments. Does not take
+         * any lock.*/
+        void doNotify(ARG_TYPES... args)
+        {
+            // Note that all operations on _activeNotificationCount and
+            // _snapshot must be sequentially consistent. See reclaimIfIdle().
+            _activeNotificationCount++;
+
+            try {
+                Snapshot_ *snapshot = _snapshot.load();
+
+                if (snapshot != nullptr) {
+                    for (auto &entry : snapshot->entries) {
+                        // the entry might have been removed after the
+                        // snapshot was published.
+                        if (entry->removed.load(std::memory_order_acquire))
+                            continue;
+
+                        try {
+                            // note: we MUST NOT use std::forward here, since
+                            // we may have to call multiple subscribers.
+                            entry->func(args...);
+                        }
+                        catch (DanglingFunctionError &) {
+                            // this is a perfectly normal case. It means that
+                            // the target function was a weak reference and
+                            // the target object has been destroyed. Just
+                            // remove it.
+                            unsubscribeById(entry->subId);
+                        }
+                    }
+                }
+            }
+            catch (...) {
+                finishNotification();
+                throw;
+            }
+
+            finishNotification();
+        }
+
+        /** Subscribes the specified function \c func.
+
+            Returns the ID of the created subscription.
+        */
+        int64_t doSubscribe(const std::function<void(ARG_TYPES...)> &func)
+        {
+            int64_t subId;
+
+            {
+                FastMutex::Lock lock(_writeMutex);
+
+                subId = _nextSubId;
+                _nextSubId++;
+
+                Snapshot_ *oldSnapshot = _snapshot.load();
+
+                Snapshot_ *newSnapshot = new Snapshot_;
+                if (oldSnapshot != nullptr) {
+                    newSnapshot->entries.reserve(oldSnapshot->entries.size() + 1);
+                    newSnapshot->entries = oldSnapshot->entries;
+                }
+                newSnapshot->entries.push_back(newObj<Entry_>(subId, func));
+
+                publish(newSnapshot);
+            }
+
+            reclaimIfIdle();
+
+            return subId;
+        }
+
+      private:
+        struct Entry_ : public Base
+        {
+            Entry_(int64_t subId, const std::function<void(ARG_TYPES...)> &func) : subId(subId), func(func) {}
+
+            int64_t subId;
+            std::atomic<bool> removed{false};
+            std::function<void(ARG_TYPES...)> func;
+        };
+
+        struct Snapshot_
+        {
+            // sorted by subscription ID (new entries are always appended and
+            // IDs increase).
+            std::vector<P<Entry_>> entries;
+        };
+
+        void unsubscribeById(int64_t subId)
+        {
+            {
+                FastMutex::Lock lock(_writeMutex);
+
+                Snapshot_ *oldSnapshot = _snapshot.load();
+                if (oldSnapshot == nullptr)
+                    return;
+
+                auto &oldEntries = oldSnapshot->entries;
+
+                auto it = std::lower_bound(oldEntries.begin(), oldEntries.end(), subId,
+                                           [](const P<Entry_> &entry, int64_t subId) { return entry->subId < subId; });
+                if (it == oldEntries.end() || (*it)->subId != subId)
+                    return;
+
+                // notifications that are currently running still see the
+                // entry in their snapshot. The flag ensures that they do not
+                // call it anymore.
+                (*it)->removed = true;
+
+                Snapshot_ *newSnapshot = nullptr;
+                if (oldEntries.size() > 1) {
+                    newSnapshot = new Snapshot_;
+                    newSnapshot->entries.reserve(oldEntries.size() - 1);
+                    newSnapshot->entries.insert(newSnapshot->entries.end(), oldEntries.begin(), it);
+                    newSnapshot->entries.insert(newSnapshot->entries.end(), it + 1, oldEntries.end());
+                }
+
+                publish(newSnapshot);
+            }
+
+            reclaimIfIdle();
+        }
+
+        /** Replaces the current snapshot. The old one is retired and deleted
+           later (see reclaimIfIdle()). _writeMutex must be locked.*/
+        void publish(Snapshot_ *newSnapshot)
+        {
+            Snapshot_ *oldSnapshot = _snapshot.exchange(newSnapshot);
+            if (oldSnapshot != nullptr) {
+                _retiredSnapshots.push_back(oldSnapshot);
+                _retiredSnapshotCount = _retiredSnapshots.size();
+            }
+        }
+
+        void finishNotification()
+        {
+            // the last notification to finish reclaims the snapshots that
+            // were retired in the meantime.
+            if (_activeNotificationCount.fetch_sub(1) == 1 && _retiredSnapshotCount.load() > 0)
+                reclaimIfIdle();
+        }
+
+        void reclaimIfIdle()
+        {
+            std::vector<Snapshot_ *> reclaimed;
+
+            {
+                FastMutex::Lock lock(_writeMutex);
+
+                if (_activeNotificationCount.load() == 0)
+                    reclaimed.swap(_retiredSnapshots);
+                _retiredSnapshotCount = _retiredSnapshots.size();
+            }
+
+            // the snapshots are deleted after the mutex was released. Deleting
+            // them can release the last reference to subscribed functions,
+            // whose destructors might in turn access the notifier.
+            for (Snapshot_ *snapshot : reclaimed)
+                delete snapshot;
+        }
+
+        class ParamlessFunctionAdapter
+        {
+          public:
+            ParamlessFunctionAdapter(std::function<void()> func) { _func = func; }
+
+            void operator()(ARG_TYPES... args) { _func(); }
+
+          protected:
+            std::function<void()> _func;
+        };
+
+        class Subscription_ : public Base, BDN_IMPLEMENTS INotifierSubscription
+        {
+          public:
+            Subscription_(int64_t subId) : _subId(subId) {}
+
+            int64_t subId() const { return _subId; }
+
+          private:
+            int64_t _subId;
+        };
+
+        // Why is it safe to delete retired snapshots when
+        // _activeNotificationCount is zero? A notification increments the
+        // counter before it loads _snapshot. A writer exchanges _snapshot
+        // before it reads the counter. All of these operations are
+        // sequentially consistent. So either the writer sees the increment
+        // (and does not delete anything), or the notification loads the new
+        // snapshot (and never sees the retired one).
+        std::atomic<Snapshot_ *> _snapshot{nullptr};
+        std::atomic<int> _activeNotificationCount{0};
+
+        FastMutex _writeMutex;
+        int64_t _nextSubId = 1;
+        std::vector<Snapshot_ *> _retiredSnapshots;
+        std::atomic<size_t> _retiredSnapshotCount{0};
+    };
+}
+
+#endif
@@ -1,7 +1,11 @@
 #ifndef BDN_Signal_H_
 #define BDN_Signal_H_
 
+#include <bdn/FastMutex.h>
+
+#include <atomic>
 #include <condition_variable>
+#include <mutex>
 
 namespace bdn
 {
@@ -25,6 +29,12 @@ namespace bdn
 
         The Signal class has nothing to do with Unix-style process signals like
        SIGKILL. It is a totally separate concept.
+
+        On Linux and Android, Signal is implemented with a FastMutex and the
+       futex system call. Waiting threads spin briefly before they go to sleep,
+       and setting or pulsing a signal that nobody waits for never enters the
+       kernel. On other platforms std::mutex and std::condition_variable are
+       used.
         */
     class Signal : public Base
     {
@@ -100,8 +110,36 @@ namespace bdn
         };
         friend class WaitingMarker;
 
-        std::mutex _mutex;
+#if BDN_HAVE_FUTEX
+        using MutexType = FastMutex;
+#else
+        using MutexType = std::mutex;
+#endif
+
+        /** Releases the lock, waits until one of the wakeUp functions is
+           called (or a spurious wakeup happens) and re-acquires the lock.
+
+            timeoutNanos is the maximum time to wait. If it is negative then
+           there is no timeout.
+
+            Returns false if the timeout expired.*/
+        bool waitForWakeUp(std::unique_lock<MutexType> &lock, int64_t timeoutNanos);
+
+        /** Wakes up one waiting thread. _mutex must be locked.*/
+        void wakeUpOne();
+
+        /** Wakes up all waiting threads. _mutex must be locked.*/
+        void wakeUpAll();
+
+        MutexType _mutex;
+
+#if BDN_HAVE_FUTEX
+        // waiting threads sleep on this futex word. It is incremented whenever
+        // the waiting threads should wake up.
+        std::atomic<uint32_t> _wakeUpSequence{0};
+#else
         std::condition_variable _condition;
+#endif
 
         bool _signalled = false;
 
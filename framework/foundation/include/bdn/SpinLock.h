@@ -0,0 +1,130 @@
+#ifndef BDN_SpinLock_H_
+#define BDN_SpinLock_H_
+
+#include <atomic>
+#include <thread>
+
+namespace bdn
+{
+
+    /** A lightweight, non-recursive lock that never puts the waiting thread to
+       sleep. Instead, threads that want to acquire a locked SpinLock
+       repeatedly check the lock state ("spin") until it becomes available.
+
+        SpinLock is only suitable for tiny critical sections that are held for a
+       few instructions (for example, to swap a pointer or to update a couple
+       of counters). For anything else use FastMutex or Mutex.
+
+        SpinLock supports the same Lock / Unlock helper interface as bdn::Mutex,
+       so it can be used as the MUTEX_TYPE parameter of generic code. Note that
+       in contrast to bdn::Mutex, SpinLock is NOT recursive. A thread that tries
+       to lock a SpinLock that it already holds will spin forever.
+
+        SpinLock does not derive from Base. It has no reference count and no
+       virtual functions and can be embedded in other objects as a plain member.
+        */
+    class SpinLock
+    {
+      public:
+        SpinLock() = default;
+
+        SpinLock(const SpinLock &) = delete;
+        SpinLock &operator=(const SpinLock &) = delete;
+
+        void lock()
+        {
+            // fast path: the lock is usually free.
+            if (!_locked.exchange(true, std::memory_order_acquire))
+                return;
+
+            lockSlow();
+        }
+
+        /** Tries to acquire the lock without waiting. Returns true if the lock
+         * was acquired.*/
+        bool tryLock()
+        {
+            return !_locked.load(std::memory_order_relaxed) && !_locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock() { _locked.store(false, std::memory_order_release); }
+
+        /** Tells the CPU that the calling thread is in a busy-wait loop. This
+           reduces the power consumption and lets a sibling hyper-thread make
+           progress.*/
+        static void relaxCpu()
+        {
+#if defined(__i386__) || defined(__x86_64__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+            __asm__ __volatile__("yield");
+#endif
+        }
+
+        /** Represents a lock on a SpinLock object. See Mutex::Lock.*/
+        class Lock
+        {
+          public:
+            Lock(SpinLock &spinLock) : _spinLock(spinLock) { _spinLock.lock(); }
+
+            Lock(SpinLock *spinLock) : Lock(*spinLock) {}
+
+            // prevent copying of the lock object
+            Lock(const Lock &) = delete;
+            Lock &operator=(const Lock &) = delete;
+
+            ~Lock() { _spinLock.unlock(); }
+
+          private:
+            SpinLock &_spinLock;
+        };
+
+        /** Temporarily unlocks a SpinLock. See Mutex::Unlock.*/
+        class Unlock
+        {
+          public:
+            Unlock(SpinLock &spinLock) : _spinLock(spinLock) { _spinLock.unlock(); }
+
+            Unlock(SpinLock *spinLock) : Unlock(*spinLock) {}
+
+            // prevent copying of the unlock object
+            Unlock(const Unlock &) = delete;
+            Unlock &operator=(const Unlock &) = delete;
+
+            ~Unlock() { _spinLock.lock(); }
+
+          private:
+            SpinLock &_spinLock;
+        };
+
+      private:
+        void lockSlow()
+        {
+            for (int spinCount = 0;; spinCount++) {
+                // only read the state while it is locked. That keeps the
+                // cache line in shared state and avoids hammering it with
+                // writes.
+                if (!_locked.load(std::memory_order_relaxed) && !_locked.exchange(true, std::memory_order_acquire))
+                    return;
+
+                // if the holder was preempted then spinning does not help.
+                // Give up our time slice from time to time so that it can run.
+                if (spinCount < yieldAfterSpinCount)
+                    relaxCpu();
+                else {
+                    spinCount = 0;
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        enum
+        {
+            yieldAfterSpinCount = 1000
+        };
+
+        std::atomic<bool> _locked{false};
+    };
+}
+
+#endif
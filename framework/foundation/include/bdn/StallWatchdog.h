@@ -0,0 +1,123 @@
+#ifndef BDN_StallWatchdog_H_
+#define BDN_StallWatchdog_H_
+
+#include <bdn/GenericDispatcher.h>
+#include <bdn/Thread.h>
+#include <bdn/Signal.h>
+#include <bdn/Mutex.h>
+
+#include <map>
+
+namespace bdn
+{
+
+#if BDN_HAVE_THREADS
+
+    /** Detects and reports stalls of a dispatcher thread (usually the main
+       thread).
+
+        The watchdog runs its own thread that regularly looks at the item that
+       the monitored GenericDispatcher is currently executing (see
+       GenericDispatcher::getActivity()). When an item executes for longer
+       than the configured budget then that is a stall. The watchdog reports
+       it through platform::Hooks::log(), including the origin of the item
+       (see DispatchOrigin and #BDN_DISPATCH_ORIGIN_SCOPE). When the item
+       finally finishes the total duration of the stall is reported as well.
+
+        The watchdog also keeps aggregate statistics about all stalls (see
+       getStatistics()).
+
+        For the main thread of apps that use GenericAppRunner the watchdog can
+       simply be enabled with GenericAppRunner::enableStallWatchdog().
+
+        The watchdog only reads the dispatcher state a few times per budget
+       period, so it does not slow down the monitored thread.
+        */
+    class StallWatchdog : public Base
+    {
+      public:
+        /** Starts watching the specified dispatcher. budgetSeconds is the
+         * maximum time that an item may execute before it is reported.*/
+        StallWatchdog(GenericDispatcher *dispatcher, double budgetSeconds);
+        ~StallWatchdog();
+
+        /** Stops the watchdog thread. It is no problem to call stop multiple
+         * times.*/
+        void stop();
+
+        double getBudgetSeconds() const { return _budgetSeconds; }
+
+        /** Aggregate information about the stalls that were detected so
+         * far.*/
+        struct Statistics
+        {
+            /** The number of items that exceeded the budget.*/
+            int64_t stallCount = 0;
+
+            /** The sum of the execution times of all stalled items (in
+               seconds). A stall that is still ongoing is included with its
+               current duration.*/
+            double totalStallSeconds = 0;
+
+            /** The execution time of the longest stalled item.*/
+            double maxStallSeconds = 0;
+
+            /** The origin of the longest stalled item (see
+             * DispatchOrigin::toString()).*/
+            String maxStallOrigin;
+
+            /** The number of stalls for each origin.*/
+            std::map<String, int64_t> stallCountByOrigin;
+        };
+
+        /** Returns the stall statistics. Can be called from any thread.*/
+        Statistics getStatistics() const;
+
+        /** Writes the stall statistics to the log.*/
+        void logStatistics() const;
+
+      private:
+        class Runnable : public ThreadRunnableBase
+        {
+          public:
+            Runnable(StallWatchdog *watchdog) : _watchdog(watchdog) {}
+
+            void signalStop() override
+            {
+                ThreadRunnableBase::signalStop();
+                _wakeUpSignal.set();
+            }
+
+            void run() override;
+
+          private:
+            StallWatchdog *_watchdog;
+            Signal _wakeUpSignal;
+        };
+        friend class Runnable;
+
+        /** Checks the dispatcher activity. Called regularly from the watchdog
+         * thread.*/
+        void check();
+
+        void stallEnded();
+
+        P<GenericDispatcher> _dispatcher;
+        double _budgetSeconds;
+
+        P<Thread> _thread;
+
+        mutable Mutex _mutex;
+        Statistics _statistics;
+
+        // information about the stall that is currently ongoing (if any)
+        bool _inStall = false;
+        int64_t _stallItemSequenceNumber = 0;
+        double _stallSeconds = 0;
+        String _stallOrigin;
+    };
+
+#endif
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef BDN_StaticSignal_H_
+#define BDN_StaticSignal_H_
+
+#include <bdn/ProgrammingError.h>
+
+#include <cstddef>
+
+namespace bdn
+{
+
+    /** A minimal, single threaded signal for internal hot paths with a small,
+       fixed maximum number of listeners.
+
+        The regular notifiers (SimpleNotifier, PropertyNotifier, etc.) are
+       reference counted heap objects with virtual functions, and each
+       subscriber is stored in a std::function. That flexibility has a price
+       that matters for signals that fire very often. StaticSignalN instead
+       stores up to CAPACITY listeners inline. A listener is a plain function
+       pointer plus a context pointer. Notifying is a simple loop over an
+       array - there is no heap allocation, no virtual function call and no
+       type erasure.
+
+        StaticSignalN can be used as a plain member variable. It cannot be
+       copied.
+
+        Listeners can connect and disconnect while a notification is running.
+       Listeners that are disconnected are not called anymore (if they have not
+       been called yet). Listeners that are connected during a notification are
+       only called by subsequent notifications.
+
+        Connecting more than CAPACITY listeners is a programming error.
+
+        StaticSignalN is NOT thread safe. See \ref StaticSignal for a variant
+       with a default capacity.
+
+        \code
+
+        class MyView
+        {
+          public:
+            StaticSignal<MyView*, int> somethingHappened;
+        };
+
+        void onSomethingHappened(void* context, MyView* view, int value);
+
+        view.somethingHappened.connect(&onSomethingHappened, this);
+
+        // or, with a method:
+        view.somethingHappened.connectMethod<MyClass, &MyClass::onSomethingHappened>(this);
+
+        \endcode
+    */
+    template <size_t CAPACITY, class... ARG_TYPES> class StaticSignalN
+    {
+      public:
+        using Func = void (*)(void *context, ARG_TYPES... args);
+
+        StaticSignalN() {}
+
+        StaticSignalN(const StaticSignalN &) = delete;
+        StaticSignalN &operator=(const StaticSignalN &) = delete;
+
+        /** Connects a listener. The listener function is called with the
+           specified context pointer as its first parameter, followed by the
+           notification arguments.*/
+        void connect(Func func, void *context)
+        {
+            if (_count == CAPACITY)
+                programmingError("StaticSignal::connect called when the maximum number of listeners is already "
+                                 "connected.");
+
+            _listeners[_count].func = func;
+            _listeners[_count].context = context;
+            _count++;
+        }
+
+        /** Connects a method of the specified object. The method pointer is a
+           template parameter, so the call does not go through a member function
+           pointer at runtime.*/
+        template <class OBJECT_TYPE, void (OBJECT_TYPE::*METHOD)(ARG_TYPES...)> void connectMethod(OBJECT_TYPE *object)
+        {
+            connect(&callMethod<OBJECT_TYPE, METHOD>, object);
+        }
+
+        /** Disconnects the listener with the specified function and context.
+           Does nothing if no such listener is connected. If the same
+           function / context combination was connected multiple times then
+           only one of them is disconnected.*/
+        void disconnect(Func func, void *context)
+        {
+            for (size_t i = 0; i < _count; i++) {
+                if (_listeners[i].func == func && _listeners[i].context == context) {
+                    removeAt(i);
+                    return;
+                }
+            }
+        }
+
+        template <class OBJECT_TYPE, void (OBJECT_TYPE::*METHOD)(ARG_TYPES...)>
+        void disconnectMethod(OBJECT_TYPE *object)
+        {
+            disconnect(&callMethod<OBJECT_TYPE, METHOD>, object);
+        }
+
+        /** Disconnects all listeners.*/
+        void disconnectAll()
+        {
+            if (_notifyDepth > 0) {
+                for (size_t i = 0; i < _count; i++)
+                    _listeners[i].func = nullptr;
+                _removedCount = _count;
+            } else
+                _count = 0;
+        }
+
+        /** Returns the number of connected listeners.*/
+        size_t getListenerCount() const { return _count - _removedCount; }
+
+        static constexpr size_t getCapacity() { return CAPACITY; }
+
+        /** Calls all connected listeners.
+
+            If a listener throws an exception then the remaining listeners are
+           not called and the exception is propagated to the caller.*/
+        void notify(ARG_TYPES... args)
+        {
+            // listeners that are connected during the notification are not
+            // called.
+            size_t count = _count;
+
+            _notifyDepth++;
+
+            try {
+                for (size_t i = 0; i < count; i++) {
+                    Func func = _listeners[i].func;
+                    if (func != nullptr)
+                        func(_listeners[i].context, args...);
+                }
+            }
+            catch (...) {
+                finishNotify();
+                throw;
+            }
+
+            finishNotify();
+        }
+
+      private:
+        template <class OBJECT_TYPE, void (OBJECT_TYPE::*METHOD)(ARG_TYPES...)>
+        static void callMethod(void *context, ARG_TYPES... args)
+        {
+            (static_cast<OBJECT_TYPE *>(context)->*METHOD)(args...);
+        }
+
+        void removeAt(size_t index)
+        {
+            if (_notifyDepth > 0) {
+                // a notification is iterating over the array. We must not
+                // move the entries, so we only mark the listener as removed.
+                if (_listeners[index].func != nullptr) {
+                    _listeners[index].func = nullptr;
+                    _removedCount++;
+                }
+            } else {
+                for (size_t i = index + 1; i < _count; i++)
+                    _listeners[i - 1] = _listeners[i];
+                _count--;
+            }
+        }
+
+        void finishNotify()
+        {
+            _notifyDepth--;
+
+            if (_notifyDepth == 0 && _removedCount > 0) {
+                size_t target = 0;
+                for (size_t i = 0; i < _count; i++) {
+                    if (_listeners[i].func != nullptr)
+                        _listeners[target++] = _listeners[i];
+                }
+                _count = target;
+                _removedCount = 0;
+            }
+        }
+
+        struct Listener
+        {
+            Func func;
+            void *context;
+        };
+
+        Listener _listeners[CAPACITY];
+        size_t _count = 0;
+        size_t _removedCount = 0;
+        int _notifyDepth = 0;
+    };
+
+    /** A StaticSignalN with room for 4 listeners (see StaticSignalN).*/
+    template <class... ARG_TYPES> using StaticSignal = StaticSignalN<4, ARG_TYPES...>;
+}
+
+#endif
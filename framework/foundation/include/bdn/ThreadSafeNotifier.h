@@ -3,34 +3,98 @@
 
 #include <bdn/IAsyncNotifier.h>
 #include <bdn/ISyncNotifier.h>
-#include <bdn/NotifierBase.h>
+#include <bdn/RcuNotifierBase.h>
+#include <bdn/FastMutex.h>
 #include <bdn/mainThread.h>
 #include <bdn/RequireNewAlloc.h>
+#include <bdn/NotificationBatch.h>
 
 #include <bdn/Map.h>
 
+#include <memory>
+#include <tuple>
+#include <utility>
+
 namespace bdn
 {
 
     /** A thread safe notifier implementation. ThreadSafeNotifier supports both
        the IAsyncNotifier and the ISyncNotifier interfaces.
 
+        The subscriber list is managed with a read-copy-update scheme (see
+       RcuNotifierBase). notify() does not take any lock, so notifications
+       from multiple threads can run concurrently without blocking each other.
+       Subscribing and unsubscribing is more expensive than with a
+       mutex-based notifier, since it copies the list of subscriptions.
+
         ThreadSafeNotifier objects MUST be allocated with newObj / new.
     */
     template <class... ARG_TYPES>
     class ThreadSafeNotifier
-        : public RequireNewAlloc<NotifierBase<Mutex, ARG_TYPES...>, ThreadSafeNotifier<ARG_TYPES...>>,
+        : public RequireNewAlloc<RcuNotifierBase<ARG_TYPES...>, ThreadSafeNotifier<ARG_TYPES...>>,
           BDN_IMPLEMENTS IAsyncNotifier<ARG_TYPES...>,
           BDN_IMPLEMENTS ISyncNotifier<ARG_TYPES...>
     {
       private:
-        using BASE = NotifierBase<Mutex, ARG_TYPES...>;
+        using BASE = RcuNotifierBase<ARG_TYPES...>;
 
       public:
         ThreadSafeNotifier() {}
 
         ~ThreadSafeNotifier() {}
 
+        /** Controls how postNotification() delivers notifications to the
+           main thread.*/
+        enum class PostingMode
+        {
+            /** Each postNotification() call results in its own notification
+               call (this is the default).*/
+            individual,
+
+            /** Only the arguments of the latest postNotification() call are
+               kept. While a delivery is pending, further postNotification()
+               calls only replace the pending arguments and do not schedule
+               additional work. So the subscribers are notified at least
+               once after the last postNotification() call, but intermediate
+               values may be skipped.
+
+                This is useful for values that are updated at a high rate from
+               a background thread (for example, progress values), where only
+               the most recent value is of interest.*/
+            coalesce
+        };
+
+        /** Sets the posting mode (see PostingMode). Can be called from any
+         * thread.*/
+        void setPostingMode(PostingMode mode)
+        {
+            FastMutex::Lock lock(_postMutex);
+            _postingMode = mode;
+        }
+
+        PostingMode getPostingMode() const
+        {
+            FastMutex::Lock lock(_postMutex);
+            return _postingMode;
+        }
+
+        /** Sets a NotificationBatch that posted notifications are added to,
+           instead of enqueueing them individually in the main dispatcher.
+           Pass null to deliver notifications individually again.
+
+            The batch can be combined with both posting modes.*/
+        void setPostingBatch(NotificationBatch *batch)
+        {
+            FastMutex::Lock lock(_postMutex);
+            _postingBatch = batch;
+        }
+
+        P<NotificationBatch> getPostingBatch() const
+        {
+            FastMutex::Lock lock(_postMutex);
+            return _postingBatch;
+        }
+
         void notify(ARG_TYPES... args) override { BASE::doNotify(std::forward<ARG_TYPES>(args)...); }
 
         void postNotification(ARG_TYPES... args) override
@@ -38,11 +102,83 @@ namespace bdn
             // see doc_input/notifier_internal.md for more information about why
             // this has to redirect to the main thread.
 
-            asyncCallFromMainThread(std::bind<void, std::function<void(ARG_TYPES...)>, ARG_TYPES...>(
-                strongMethod(this, &ThreadSafeNotifier::notify), std::forward<ARG_TYPES>(args)...));
+            P<ThreadSafeNotifier> self = this;
+            P<NotificationBatch> batch;
+            bool coalesce;
+
+            {
+                FastMutex::Lock lock(_postMutex);
+
+                batch = _postingBatch;
+                coalesce = (_postingMode == PostingMode::coalesce);
+
+                if (coalesce) {
+                    if (_pendingArgs == nullptr)
+                        _pendingArgs = std::make_unique<ArgsTuple>(args...);
+                    else
+                        *_pendingArgs = ArgsTuple(args...);
+
+                    // if a delivery is already pending then it will pick up
+                    // the new arguments.
+                    if (_coalescedDeliveryPending)
+                        return;
+
+                    _coalescedDeliveryPending = true;
+                }
+            }
+
+            // note that we schedule outside the lock, so that we never hold
+            // our mutex and the dispatcher mutex at the same time.
+            if (coalesce)
+                schedule([self]() { self->deliverCoalesced(); }, batch);
+            else
+                schedule([ self, args = ArgsTuple(args...) ]() mutable { self->notifyWithTuple(args, IndexSequence()); },
+                         batch);
         }
 
       private:
+        using ArgsTuple = std::tuple<typename std::decay<ARG_TYPES>::type...>;
+        using IndexSequence = std::index_sequence_for<ARG_TYPES...>;
+
+        template <size_t... INDICES> void notifyWithTuple(ArgsTuple &args, std::index_sequence<INDICES...>)
+        {
+            notify(std::get<INDICES>(args)...);
+        }
+
+        void schedule(std::function<void()> delivery, NotificationBatch *batch)
+        {
+            if (batch != nullptr)
+                batch->add(std::move(delivery));
+            else
+                getMainDispatcher()->enqueue(std::move(delivery));
+        }
+
+        void deliverCoalesced()
+        {
+            std::unique_ptr<ArgsTuple> args;
+
+            {
+                FastMutex::Lock lock(_postMutex);
+
+                args = std::move(_pendingArgs);
+
+                // calls to postNotification that happen during the
+                // notification must schedule a new delivery.
+                _coalescedDeliveryPending = false;
+            }
+
+            if (args != nullptr)
+                notifyWithTuple(*args, IndexSequence());
+        }
+
+        // note that _postMutex is separate from the subscription mutex of the
+        // base class. Posting only needs to synchronize with other posting
+        // threads, not with notification calls.
+        mutable FastMutex _postMutex;
+        PostingMode _postingMode = PostingMode::individual;
+        P<NotificationBatch> _postingBatch;
+        std::unique_ptr<ArgsTuple> _pendingArgs;
+        bool _coalescedDeliveryPending = false;
     };
 }
 
@@ -18,6 +18,13 @@
 #define BDN_HAVE_THREADS 1
 #define BDN_COMPILER_STATIC_CONSTRUCTION_THREAD_SAFE 1
 
+#if defined(__linux__)
+// Linux (and Android) provide the futex system call, which allows us to
+// implement mutexes and signals that only enter the kernel when a thread
+// actually has to sleep.
+#define BDN_HAVE_FUTEX 1
+#endif
+
 #if BDN_PLATFORM_ANDROID
 // the c++_shared and c++_static standard libraries do not implement the full
 // locale api and the android docs state that support for wchar_t is "limited".
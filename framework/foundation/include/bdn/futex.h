@@ -0,0 +1,45 @@
+#ifndef BDN_futex_H_
+#define BDN_futex_H_
+
+#if BDN_HAVE_FUTEX
+
+#include <atomic>
+#include <cstdint>
+
+namespace bdn
+{
+    namespace futex
+    {
+
+        /** Puts the calling thread to sleep if \c word still has the value \c
+           expectedValue. The check and the transition to the sleeping state
+           happen atomically, so a wake call that happens after \c word was
+           modified cannot be missed.
+
+            timeoutNanos is the maximum time to sleep in nanoseconds. If it is
+           negative then there is no timeout.
+
+            Note that wait can return spuriously (for example, if the thread
+           receives a unix signal). Callers must always re-check their
+           condition.
+
+            \return false if the timeout expired, true otherwise.*/
+        bool wait(std::atomic<uint32_t> &word, uint32_t expectedValue, int64_t timeoutNanos = -1);
+
+        /** Wakes up at most \c count threads that are sleeping in wait() for
+         * the specified word.*/
+        void wake(std::atomic<uint32_t> &word, int count);
+
+        /** Wakes up one thread that is sleeping in wait() for the specified
+         * word.*/
+        inline void wakeOne(std::atomic<uint32_t> &word) { wake(word, 1); }
+
+        /** Wakes up all threads that are sleeping in wait() for the specified
+         * word.*/
+        void wakeAll(std::atomic<uint32_t> &word);
+    }
+}
+
+#endif // BDN_HAVE_FUTEX
+
+#endif
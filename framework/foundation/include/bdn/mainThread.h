@@ -4,8 +4,10 @@
 #include <bdn/ISimpleCallable.h>
 #include <bdn/Thread.h>
 #include <bdn/IDispatcher.h>
+#include <bdn/DispatchOrigin.h>
 
 #include <future>
+#include <typeinfo>
 
 namespace bdn
 {
@@ -13,16 +15,40 @@ namespace bdn
     class CallFromMainThreadBase_ : public Base, BDN_IMPLEMENTS ISimpleCallable
     {
       public:
-        void dispatchCall() { getMainDispatcher()->enqueue(Caller(this)); }
+        void dispatchCall()
+        {
+            DispatchOrigin::Scope originScope(getOrigin());
+            getMainDispatcher()->enqueue(Caller(this));
+        }
 
         void dispatchCallWithDelaySeconds(double seconds)
         {
+            DispatchOrigin::Scope originScope(getOrigin());
             getMainDispatcher()->enqueueInSeconds(seconds, Caller(this));
         }
 
-        void dispatchCallWhenIdle() { getMainDispatcher()->enqueue(Caller(this), IDispatcher::Priority::idle); }
+        void dispatchCallWhenIdle()
+        {
+            DispatchOrigin::Scope originScope(getOrigin());
+            getMainDispatcher()->enqueue(Caller(this), IDispatcher::Priority::idle);
+        }
+
+      protected:
+        /** Returns the type of the function that is called.*/
+        virtual const std::type_info &getFuncType() const = 0;
 
       private:
+        /** Returns the origin to record for the dispatcher item (see
+           DispatchOrigin). Without this, the dispatcher would only see our
+           Caller type, which is the same for all calls.*/
+        DispatchOrigin getOrigin() const
+        {
+            DispatchOrigin origin = DispatchOrigin::getCurrent();
+            if (!origin.isKnown())
+                origin.callableTypeName = getFuncType().name();
+            return origin;
+        }
+
         class Caller
         {
           public:
@@ -57,6 +83,8 @@ namespace bdn
         }
 
       protected:
+        const std::type_info &getFuncType() const override { return typeid(FuncType); }
+
         std::packaged_task<typename std::result_of<FuncType(Args...)>::type()> _packagedTask;
     };
 
@@ -3,6 +3,8 @@
 #include <bdn/String.h>
 #include <bdn/safeStatic.h>
 
+#include <memory>
+
 #include <bdn/log.h>
 
 namespace bdn
@@ -2,7 +2,11 @@
 #define BDN_property_H_
 
 #include <bdn/PlainPropertyReadAccessor.h>
+#include <bdn/PropertyBatch.h>
 #include <bdn/PropertyNotifier.h>
+#include <bdn/PropertyNotifierTable.h>
+
+#include <utility>
 
 namespace bdn
 {
@@ -169,10 +173,15 @@ namespace bdn
    is needed for the changed notifier. See \ref BDN_FINALIZE_CUSTOM_PROPERTY for
    more information.
 
-    The macro adds a pointer bdn::PropertyNotifier object as a member variable
-   and generates the "changed" function so that it returns a reference to the
-   notifier. In the current implementation, the notifier object is allocated
-    dynamically on first use - so it adds only minimal overhead when not used.
+    The macro generates the "changed" function so that it returns a reference
+   to a bdn::PropertyNotifier object. The notifier is stored in the owner's
+   PropertyNotifierTable and is only allocated when the "changed" function is
+   called for the first time. The macro does not add any member variables to
+   the class. As long as nobody has requested the notifier,
+   \ref BDN_NOTIFY_PROPERTY_CHANGED does not allocate anything and only costs
+   a null pointer check.
+
+    The owner class must be derived from bdn::Base.
 
     \param valueType the type of the internal property value. This must be a
    valid C++ type or class name. \param propertyName the name of the property
@@ -187,13 +196,13 @@ namespace bdn
 #define BDN_PROPERTY_CHANGED_DEFAULT_IMPLEMENTATION(valueType, propertyName, ...)                                      \
     virtual bdn::IPropertyNotifier<valueType> &propertyName##Changed() const __VA_ARGS__                               \
     {                                                                                                                  \
-        if (_propertyChanged_##propertyName == nullptr)                                                                \
-            _propertyChanged_##propertyName = bdn::newObj<bdn::PropertyNotifier<valueType>>();                         \
-        return *_propertyChanged_##propertyName;                                                                       \
+        return bdn::PropertyNotifierTable::getOrCreate<valueType>(this, #propertyName);                                \
     }                                                                                                                  \
                                                                                                                        \
-  private:                                                                                                             \
-    mutable bdn::P<bdn::PropertyNotifier<valueType>> _propertyChanged_##propertyName;                                  \
+    bdn::PropertyNotifier<valueType> *_propertyChangedIfCreated_##propertyName() const                                 \
+    {                                                                                                                  \
+        return bdn::PropertyNotifierTable::find<valueType>(this, #propertyName);                                       \
+    }                                                                                                                  \
                                                                                                                        \
   public:
 
@@ -296,6 +305,51 @@ namespace bdn
     BDN_PROPERTY_CHANGED_DEFAULT_IMPLEMENTATION(valueType, name);                                                      \
     BDN_FINALIZE_CUSTOM_PROPERTY(valueType, name, setterName, __VA_ARGS__);
 
+/** \def BDN_REF_PROPERTY( valueType, name, setterName, ... )
+
+    Like \ref BDN_PROPERTY, but optimized for value types that are expensive to
+   copy (strings, arrays, buffers) or that can only be moved.
+
+    - The getter returns a const reference to the stored value instead of a
+      copy.
+    - The setter takes its parameter by value and moves it into the stored
+      value. So callers can pass temporaries or use std::move to transfer the
+      value without copying it.
+    - Subscribers of the changed notifier receive a reference to the stored
+      value. No copy is made for the notification (see
+      IPropertyReadAccessor::getValuePointer()).
+
+    Note that since subscribers get a reference to the stored value, a
+   subscriber that modifies the property will see the parameter change to the
+   new value.
+
+    Unlike BDN_PROPERTY, a BDN_REF_PROPERTY cannot implement a property that
+   was declared with \ref BDN_ABSTRACT_PROPERTY, since the getter and setter
+   signatures differ.
+
+    \param valueType the type of the internal property value. This must be a
+   valid C++ type or class name. \param name the name of the property \param
+   setterName the name of the property's setter function \param ... The fourth
+   parameter is optional. It can either be omitted or it can be a combination of
+        override and/or final (see \ref BDN_PROPERTY).
+    */
+#define BDN_REF_PROPERTY(valueType, name, setterName, ...)                                                             \
+    virtual const valueType &name() const __VA_ARGS__ { return _propertyValue_##name; }                                \
+    virtual void setterName(valueType value) __VA_ARGS__                                                               \
+    {                                                                                                                  \
+        if (_propertyValue_##name != value) {                                                                          \
+            _propertyValue_##name = std::move(value);                                                                  \
+            BDN_NOTIFY_PROPERTY_CHANGED(*this, name);                                                                  \
+        }                                                                                                              \
+    }                                                                                                                  \
+                                                                                                                       \
+  private:                                                                                                             \
+    valueType _propertyValue_##name{};                                                                                 \
+                                                                                                                       \
+  public:                                                                                                              \
+    BDN_PROPERTY_CHANGED_DEFAULT_IMPLEMENTATION(valueType, name);                                                      \
+    BDN_FINALIZE_CUSTOM_PROPERTY(valueType, name, setterName, __VA_ARGS__);
+
 /** \def BDN_ABSTRACT_PROPERTY( valueType, name, setterName )
 
     Defines an abstract property - i.e. a property whose implementation must be
@@ -347,18 +401,67 @@ namespace bdn
     virtual IPropertyNotifier<valueType> &name##Changed() const = 0;                                                   \
     using PropertyValueType_##name = valueType;
 
+    /** Helper for \ref BDN_NOTIFY_PROPERTY_CHANGED. Used for properties that
+       have the default "changed" implementation. Returns the notifier, or
+       null if it has not been created yet.*/
+    template <typename OWNER_TYPE, typename FIND_FUNC_TYPE, typename CHANGED_FUNC_TYPE>
+    auto _getPropertyNotifierForNotify(const OWNER_TYPE &owner, FIND_FUNC_TYPE findFunc, CHANGED_FUNC_TYPE, int)
+        -> decltype(findFunc(owner))
+    {
+        return findFunc(owner);
+    }
+
+    /** Helper for \ref BDN_NOTIFY_PROPERTY_CHANGED. Used for properties with
+       a custom "changed" implementation.*/
+    template <typename OWNER_TYPE, typename FIND_FUNC_TYPE, typename CHANGED_FUNC_TYPE>
+    auto _getPropertyNotifierForNotify(const OWNER_TYPE &owner, FIND_FUNC_TYPE, CHANGED_FUNC_TYPE changedFunc, long)
+        -> decltype(changedFunc(owner))
+    {
+        return changedFunc(owner);
+    }
+
+    template <typename OWNER_TYPE, typename NOTIFIER_TYPE, typename ACCESSOR_TYPE>
+    void _notifyPropertyChanged(const OWNER_TYPE &owner, NOTIFIER_TYPE *notifier, const ACCESSOR_TYPE &accessor)
+    {
+        if (notifier != nullptr) {
+            if (PropertyBatch::isActive()) {
+                // the notifier identifies the property, so repeated changes
+                // are only notified once. The accessor reads the final value
+                // when the batch ends. Until then we keep the owner alive.
+                P<const IBase> ownerRef = &owner;
+                P<NOTIFIER_TYPE> notifierRef = notifier;
+                ACCESSOR_TYPE accessorCopy = accessor;
+                PropertyBatch::defer(notifier, 0,
+                                     [ownerRef, notifierRef, accessorCopy]() { notifierRef->notify(accessorCopy); });
+            } else
+                notifier->notify(accessor);
+        }
+    }
+
 /** \def BDN_NOTIFY_PROPERTY_CHANGED( owner, name )
 
     Indicates that the value of a property has changed and calls "notify" on the
     changed notifier of the property.
 
+    If the property uses the default "changed" implementation (see \ref
+   BDN_PROPERTY_CHANGED_DEFAULT_IMPLEMENTATION) and nobody has requested the
+   notifier yet then nothing happens and no notifier object is allocated.
+
     \param owner the owner of the property (a reference or object, not a
    pointer) \param name the name of the property. This must be the same name
    that was also specified when the property was defined (see \ref
    BDN_PROPERTY).
     */
 #define BDN_NOTIFY_PROPERTY_CHANGED(owner, name)                                                                       \
-    (owner).name##Changed().notify(BDN_PROPERTY_READ_ACCESSOR(owner, name));
+    bdn::_notifyPropertyChanged(                                                                                       \
+        owner,                                                                                                         \
+        bdn::_getPropertyNotifierForNotify(                                                                            \
+            owner,                                                                                                     \
+            [](const auto &o) -> decltype(o._propertyChangedIfCreated_##name()) {                                      \
+                return o._propertyChangedIfCreated_##name();                                                           \
+            },                                                                                                         \
+            [](const auto &o) -> decltype(&o.name##Changed()) { return &o.name##Changed(); }, 0),                      \
+        BDN_PROPERTY_READ_ACCESSOR(owner, name));
 
 /** Provides a way to disambiguate a property when the same property is
    inherited from multiple base classes / interfaces.
@@ -1,6 +1,8 @@
 #include <bdn/init.h>
 #include <bdn/Base.h>
 
+#include <bdn/PropertyNotifierTable.h>
+
 namespace bdn
 {
 
@@ -83,6 +85,8 @@ namespace bdn
 
     Base::~Base()
     {
+        delete _propertyNotifierTable;
+
         WeakReferenceState_ *weakReferenceState = _weakReferenceState.load();
         if (weakReferenceState != nullptr) {
             // this should never happen. Weak references should ONLY be created
@@ -124,6 +128,8 @@ namespace bdn
         }
     }
 
+    void Base::_createPropertyNotifierTable() const { _propertyNotifierTable = new PropertyNotifierTable; }
+
     void Base::_refCountReachedZero()
     {
         // the reference count has reached zero. That means that no more strong
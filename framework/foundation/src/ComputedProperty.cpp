@@ -0,0 +1,93 @@
+#include <bdn/init.h>
+#include <bdn/ComputedProperty.h>
+
+#include <bdn/PropertyNotificationPhase.h>
+
+namespace bdn
+{
+
+    bool ComputedPropertyTracker::reuseDependency(const void *key)
+    {
+        for (auto &dep : _dependencies) {
+            if (dep.key == key)
+                return true;
+        }
+
+        for (auto it = _previousDependencies.begin(); it != _previousDependencies.end(); ++it) {
+            if (it->key == key) {
+                _dependencies.push_back(std::move(*it));
+                _previousDependencies.erase(it);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    ComputedPropertyBase::~ComputedPropertyBase()
+    {
+        for (auto &dep : _dependencies)
+            dep.unsubscribe();
+    }
+
+    SimpleNotifier<> &ComputedPropertyBase::invalidated() const
+    {
+        if (_invalidatedNotifier == nullptr)
+            _invalidatedNotifier = newObj<SimpleNotifier<>>();
+
+        return *_invalidatedNotifier;
+    }
+
+    void ComputedPropertyBase::invalidate()
+    {
+        // if we are already dirty then our dependents have also been
+        // invalidated already (they cannot have computed their value without
+        // reading ours).
+        if (_dirty)
+            return;
+
+        _dirty = true;
+
+        if (_invalidatedNotifier != nullptr)
+            _invalidatedNotifier->notify();
+
+        if (isObserved() && !_recomputeScheduled) {
+            _recomputeScheduled = true;
+
+            P<ComputedPropertyBase> self = this;
+            PropertyNotificationPhase::defer([self]() {
+                self->_recomputeScheduled = false;
+                self->recomputeAndNotify();
+            });
+        }
+    }
+
+    void ComputedPropertyBase::recompute() const
+    {
+        ComputedPropertyTracker tracker(const_cast<ComputedPropertyBase *>(this), std::move(_dependencies));
+        _dependencies.clear();
+
+        // we clear the dirty flag before we compute. If a dependency changes
+        // while we compute then we are invalidated again.
+        _dirty = false;
+
+        try {
+            computeValue(tracker);
+        }
+        catch (...) {
+            _dirty = true;
+
+            // keep all subscriptions, so that we get notified if the
+            // problem is resolved by a dependency change.
+            for (auto &dep : tracker._previousDependencies)
+                tracker._dependencies.push_back(std::move(dep));
+            _dependencies = std::move(tracker._dependencies);
+            throw;
+        }
+
+        for (auto &dep : tracker._previousDependencies)
+            dep.unsubscribe();
+
+        _dependencies = std::move(tracker._dependencies);
+    }
+}
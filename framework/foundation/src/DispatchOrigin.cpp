@@ -0,0 +1,66 @@
+#include <bdn/init.h>
+#include <bdn/DispatchOrigin.h>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace bdn
+{
+
+    namespace
+    {
+        // DispatchOrigin is a plain struct with a trivial destructor, so we
+        // do not need SafeInit here.
+#if BDN_HAVE_THREADS
+        thread_local DispatchOrigin currentDispatchOrigin;
+#else
+        DispatchOrigin currentDispatchOrigin;
+#endif
+
+        String demangleTypeName(const char *typeName)
+        {
+#if defined(__GNUC__)
+            int status = 0;
+            char *demangled = abi::__cxa_demangle(typeName, nullptr, nullptr, &status);
+            if (demangled != nullptr) {
+                String result(demangled);
+                free(demangled);
+                return result;
+            }
+#endif
+            return typeName;
+        }
+    }
+
+    String DispatchOrigin::toString() const
+    {
+        if (file != nullptr) {
+            // only use the file name. The full path is usually long and
+            // specific to the build machine.
+            const char *fileName = file;
+            for (const char *curr = file; *curr != 0; curr++) {
+                if (*curr == '/' || *curr == '\\')
+                    fileName = curr + 1;
+            }
+
+            return String(fileName) + ":" + std::to_string(line);
+        }
+
+        if (callableTypeName != nullptr)
+            return demangleTypeName(callableTypeName);
+
+        return "unknown";
+    }
+
+    DispatchOrigin DispatchOrigin::getCurrent() { return currentDispatchOrigin; }
+
+    DispatchOrigin::Scope::Scope(const DispatchOrigin &origin)
+    {
+        _prevOrigin = currentDispatchOrigin;
+        currentDispatchOrigin = origin;
+    }
+
+    DispatchOrigin::Scope::~Scope() { currentDispatchOrigin = _prevOrigin; }
+}
@@ -0,0 +1,57 @@
+#include <bdn/init.h>
+#include <bdn/FastMutex.h>
+
+#if BDN_HAVE_FUTEX
+
+#include <bdn/futex.h>
+
+#include <algorithm>
+
+namespace bdn
+{
+
+    enum
+    {
+        // the maximum number of iterations that we spin before we go to
+        // sleep. A single iteration takes a few dozen nanoseconds, so this is
+        // roughly in the range of the cost of a sleep / wakeup cycle.
+        fastMutexMaxSpinCount = 100,
+        fastMutexMinSpinCount = 10
+    };
+
+    void FastMutex::lockSlow()
+    {
+        // adaptive spinning: we spin up to twice as long as it usually took
+        // in the past to get the mutex.
+        int spinEstimate = _spinEstimate.load(std::memory_order_relaxed);
+        int maxSpinCount = std::min<int>(fastMutexMaxSpinCount, spinEstimate * 2 + fastMutexMinSpinCount);
+
+        for (int spinCount = 0; spinCount < maxSpinCount; spinCount++) {
+            uint32_t state = _state.load(std::memory_order_relaxed);
+            if (state == unlocked &&
+                _state.compare_exchange_weak(state, locked, std::memory_order_acquire, std::memory_order_relaxed)) {
+                _spinEstimate.store(spinEstimate + (spinCount - spinEstimate) / 8, std::memory_order_relaxed);
+                return;
+            }
+
+            SpinLock::relaxCpu();
+        }
+
+        _spinEstimate.store(spinEstimate + (maxSpinCount - spinEstimate) / 8, std::memory_order_relaxed);
+
+        // spinning did not get us the mutex. Mark it as having waiters and go
+        // to sleep. Note that when we get the mutex through the exchange then
+        // it is marked as having waiters, even if there are none. That only
+        // causes an unnecessary wake call in unlock - it does not affect
+        // correctness.
+        uint32_t state = _state.exchange(lockedWithWaiters, std::memory_order_acquire);
+        while (state != unlocked) {
+            futex::wait(_state, lockedWithWaiters);
+            state = _state.exchange(lockedWithWaiters, std::memory_order_acquire);
+        }
+    }
+
+    void FastMutex::wakeWaiter() { futex::wakeOne(_state); }
+}
+
+#endif
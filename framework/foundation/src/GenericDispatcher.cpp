@@ -6,13 +6,81 @@
 namespace bdn
 {
 
+    void GenericDispatcher::enqueueSerial(const String &serialKey, std::function<void()> func,
+                                          Priority priority)
+    {
+        if (serialKey.isEmpty())
+            throw InvalidArgumentError("GenericDispatcher::enqueueSerial must be called with a non-empty serial key");
+
+        FastMutex::Lock lock(_mutex);
+
+        Item item(func, priority, Clock::now(), getOrigin(func), serialKey);
+
+        auto it = _serialKeyMap.find(serialKey);
+        if (it != _serialKeyMap.end()) {
+            // another item with this key is queued or executing. This one has
+            // to wait until that has finished.
+            it->second.push_back(item);
+        } else {
+            _serialKeyMap[serialKey];
+            getQueue(priority).push_back(item);
+        }
+
+        _queuedItemCount++;
+        updateMaxQueuedItemCount();
+
+        _somethingChangedSignal.set();
+    }
+
     bool GenericDispatcher::executeNext()
     {
         // go through the queues in priority order and handle one item
-        std::function<void()> func;
-        if (getNextReady(func, true)) {
+        Item item;
+        bool haveItem;
+        int64_t itemSequenceNumber = 0;
+
+        {
+            FastMutex::Lock lock(_mutex);
+            haveItem = getNextReady(item, true);
+            if (haveItem) {
+                itemStarting(item);
+                itemSequenceNumber = _itemSequenceNumber;
+            }
+        }
+
+        if (haveItem) {
+            // when the item has finished (or thrown an exception) then we
+            // must update the statistics and release its serial key (if it
+            // has one).
+            class Finisher
+            {
+              public:
+                Finisher(GenericDispatcher *dispatcher, const String &serialKey, int64_t itemSequenceNumber)
+                    : _dispatcher(dispatcher), _serialKey(serialKey), _itemSequenceNumber(itemSequenceNumber)
+                {}
+
+                ~Finisher()
+                {
+                    FastMutex::Lock lock(_dispatcher->_mutex);
+
+                    _dispatcher->_executingItemCount--;
+                    if (_dispatcher->_itemSequenceNumber == _itemSequenceNumber)
+                        _dispatcher->_currentItemExecuting = false;
+
+                    if (!_serialKey.isEmpty())
+                        _dispatcher->releaseSerialKey(_serialKey);
+                }
+
+              private:
+                GenericDispatcher *_dispatcher;
+                const String &_serialKey;
+                int64_t _itemSequenceNumber;
+            };
+
+            Finisher finisher(this, item.serialKey, itemSequenceNumber);
+
             try {
-                func();
+                item.func();
             }
             catch (DanglingFunctionError &) {
                 // DanglingFunctionError exceptions are ignored. They indicate
@@ -35,11 +103,11 @@ namespace bdn
             double currWaitSeconds = 0;
 
             {
-                Mutex::Lock lock(_mutex);
+                FastMutex::Lock lock(_mutex);
 
-                std::function<void()> func;
+                Item item;
 
-                if (getNextReady(func, false)) {
+                if (getNextReady(item, false)) {
                     // we have items pending that are ready to be executed.
                     return true;
                 } else if (timeoutSeconds <= 0) {
@@ -102,24 +170,142 @@ namespace bdn
         return false;
     }
 
-    bool GenericDispatcher::getNextReady(std::function<void()> &func, bool remove)
+    bool GenericDispatcher::getNextReady(Item &item, bool remove)
     {
-        Mutex::Lock lock(_mutex);
-
         enqueueTimedItemsIfTimeReached();
 
         // go through the queues in priority order and handle one item
         for (int priorityIndex = priorityCount - 1; priorityIndex >= 0; priorityIndex--) {
-            List<std::function<void()>> &queue = _queues[priorityIndex];
+            List<Item> &queue = _queues[priorityIndex];
 
             if (!queue.empty()) {
-                func = queue.front();
-                if (remove)
+                if (remove) {
+                    item = std::move(queue.front());
                     queue.pop_front();
+                    _queuedItemCount--;
+                }
                 return true;
             }
         }
 
         return false;
     }
+
+    void GenericDispatcher::releaseSerialKey(const String &serialKey)
+    {
+        auto it = _serialKeyMap.find(serialKey);
+
+        // note that the entry might not exist anymore if the dispatcher was
+        // disposed in the meantime.
+        if (it != _serialKeyMap.end()) {
+            List<Item> &waitingItems = it->second;
+
+            if (waitingItems.empty())
+                _serialKeyMap.erase(it);
+            else {
+                // the next item with the key can now be executed. Note that it
+                // keeps its original ready time, so the time it had to wait
+                // for the key is included in the wait statistics.
+                Item &nextItem = waitingItems.front();
+                getQueue(nextItem.priority).push_back(std::move(nextItem));
+                waitingItems.pop_front();
+
+                _somethingChangedSignal.set();
+            }
+        }
+    }
+
+    void GenericDispatcher::itemStarting(const Item &item)
+    {
+        TimePoint now = Clock::now();
+
+        _itemSequenceNumber++;
+        _currentItemExecuting = true;
+        _currentItemStartTime = now;
+        _currentItemOrigin = item.origin;
+
+        Duration waitDuration = now - item.readyTime;
+        if (waitDuration < Duration::zero())
+            waitDuration = Duration::zero();
+
+        _totalWaitDuration += waitDuration;
+        if (waitDuration > _maxWaitDuration)
+            _maxWaitDuration = waitDuration;
+
+        _executingItemCount++;
+        _executedItemCount++;
+    }
+
+    GenericDispatcher::Statistics GenericDispatcher::getStatistics() const
+    {
+        FastMutex::Lock lock(_mutex);
+
+        Statistics stats;
+        stats.queuedItemCount = _queuedItemCount;
+        stats.maxQueuedItemCount = _maxQueuedItemCount;
+        stats.timedItemCount = (int64_t)_timedItemMap.size();
+        stats.executingItemCount = _executingItemCount;
+        stats.executedItemCount = _executedItemCount;
+
+        if (_executedItemCount > 0)
+            stats.averageWaitSeconds = durationToSeconds(_totalWaitDuration) / _executedItemCount;
+        stats.maxWaitSeconds = durationToSeconds(_maxWaitDuration);
+
+        return stats;
+    }
+
+    GenericDispatcher::Activity GenericDispatcher::getActivity() const
+    {
+        FastMutex::Lock lock(_mutex);
+
+        Activity activity;
+        activity.itemSequenceNumber = _itemSequenceNumber;
+        activity.executing = _currentItemExecuting;
+        if (_currentItemExecuting) {
+            activity.executingSeconds = durationToSeconds(Clock::now() - _currentItemStartTime);
+            activity.origin = _currentItemOrigin;
+        }
+
+        return activity;
+    }
+
+    void GenericDispatcher::resetStatistics()
+    {
+        FastMutex::Lock lock(_mutex);
+
+        _maxQueuedItemCount = _queuedItemCount;
+        _executedItemCount = 0;
+        _totalWaitDuration = Duration::zero();
+        _maxWaitDuration = Duration::zero();
+    }
+
+#if BDN_HAVE_THREADS
+
+    GenericDispatcher::WorkerPool::WorkerPool(GenericDispatcher *dispatcher, int threadCount)
+    {
+        _dispatcher = dispatcher;
+
+        if (threadCount <= 0) {
+            threadCount = (int)std::thread::hardware_concurrency();
+            if (threadCount <= 0)
+                threadCount = 1;
+        }
+
+        for (int i = 0; i < threadCount; i++)
+            _threads.add(newObj<Thread>(newObj<ThreadRunnable>(dispatcher)));
+    }
+
+    GenericDispatcher::WorkerPool::~WorkerPool() { stop(); }
+
+    void GenericDispatcher::WorkerPool::stop()
+    {
+        // signal all threads first so that they can wind down in parallel.
+        for (auto &thread : _threads)
+            thread->signalStop();
+
+        for (auto &thread : _threads)
+            thread->stop(Thread::ExceptionIgnore);
+    }
+
+#endif
 }
@@ -0,0 +1,187 @@
+#include <bdn/init.h>
+#include <bdn/InstrumentedDispatcher.h>
+
+#include <bdn/log.h>
+
+namespace bdn
+{
+
+    namespace
+    {
+        /** Records the execution time of an item when it goes out of scope.
+           This ensures that items that throw an exception are also
+           recorded.*/
+        class ExecutionTimeRecorder
+        {
+          public:
+            ExecutionTimeRecorder(LatencyHistogram &histogram)
+                : _histogram(histogram), _startTime(std::chrono::steady_clock::now())
+            {}
+
+            ~ExecutionTimeRecorder()
+            {
+                _histogram.record(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _startTime)
+                        .count());
+            }
+
+          private:
+            LatencyHistogram &_histogram;
+            std::chrono::steady_clock::time_point _startTime;
+        };
+    }
+
+    InstrumentedDispatcher::InstrumentedDispatcher(IDispatcher *innerDispatcher)
+    {
+        _innerDispatcher = innerDispatcher;
+        _data = newObj<Data>();
+    }
+
+    void InstrumentedDispatcher::enqueue(std::function<void()> func, Priority priority)
+    {
+        P<Data> data = _data;
+        PriorityData &priorityData = data->getPriorityData(priority);
+
+        Clock::time_point enqueueTime = Clock::now();
+
+        priorityData.itemQueued();
+
+        try {
+            _innerDispatcher->enqueue(
+                [data, &priorityData, enqueueTime, func = std::move(func)]() {
+                    priorityData.queuedItemCount.fetch_sub(1, std::memory_order_relaxed);
+                    priorityData.waitTime.record(nanosSince(enqueueTime));
+
+                    ExecutionTimeRecorder recorder(priorityData.executionTime);
+                    func();
+                },
+                priority);
+        }
+        catch (...) {
+            priorityData.queuedItemCount.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    void InstrumentedDispatcher::enqueueInSeconds(double seconds, std::function<void()> func, Priority priority)
+    {
+        if (seconds <= 0) {
+            enqueue(func, priority);
+            return;
+        }
+
+        P<Data> data = _data;
+        PriorityData &priorityData = data->getPriorityData(priority);
+
+        Clock::time_point scheduledTime =
+            Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+
+        _innerDispatcher->enqueueInSeconds(seconds,
+                                           [data, &priorityData, scheduledTime, func = std::move(func)]() {
+                                               data->timerLateness.record(nanosSince(scheduledTime));
+
+                                               ExecutionTimeRecorder recorder(priorityData.executionTime);
+                                               func();
+                                           },
+                                           priority);
+    }
+
+    void InstrumentedDispatcher::createTimer(double intervalSeconds, std::function<bool()> func)
+    {
+        P<Data> data = _data;
+
+        Clock::duration interval =
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(intervalSeconds));
+
+        // the time at which we expect the next timer event
+        Clock::time_point expectedTime = Clock::now() + interval;
+
+        auto timerFunc = [data, interval, expectedTime, func = std::move(func)]() mutable -> bool {
+            Clock::time_point now = Clock::now();
+
+            data->timerLateness.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - expectedTime).count());
+
+            // if events were skipped (because the dispatcher was busy) then
+            // the next event is the first one after "now". That matches the
+            // behaviour described in IDispatcher::createTimer.
+            expectedTime += interval;
+            if (expectedTime < now && interval > Clock::duration::zero())
+                expectedTime += ((now - expectedTime) / interval + 1) * interval;
+
+            ExecutionTimeRecorder recorder(data->normal.executionTime);
+            return func();
+        };
+
+        _innerDispatcher->createTimer(intervalSeconds, timerFunc);
+    }
+
+    InstrumentedDispatcher::Snapshot InstrumentedDispatcher::getSnapshot() const
+    {
+        Snapshot snapshot;
+
+        snapshot.normal = _data->normal.getSnapshot();
+        snapshot.idle = _data->idle.getSnapshot();
+        snapshot.timerLateness = _data->timerLateness.getSnapshot();
+
+        return snapshot;
+    }
+
+    void InstrumentedDispatcher::reset()
+    {
+        _data->normal.reset();
+        _data->idle.reset();
+        _data->timerLateness.reset();
+    }
+
+    void InstrumentedDispatcher::logSnapshot(const String &title) const
+    {
+        Snapshot snapshot = getSnapshot();
+
+        const PrioritySnapshot *prioritySnapshots[] = {&snapshot.normal, &snapshot.idle};
+        const char *priorityNames[] = {"normal", "idle"};
+
+        for (int i = 0; i < 2; i++) {
+            const PrioritySnapshot &prioritySnapshot = *prioritySnapshots[i];
+
+            log(Severity::Info, "Dispatcher " + title + " [" + priorityNames[i] +
+                                    "] queued=" + std::to_string(prioritySnapshot.queuedItemCount) +
+                                    " maxQueued=" + std::to_string(prioritySnapshot.maxQueuedItemCount));
+            log(Severity::Info,
+                "Dispatcher " + title + " [" + priorityNames[i] + "] wait: " + prioritySnapshot.waitTime.toString());
+            log(Severity::Info, "Dispatcher " + title + " [" + priorityNames[i] +
+                                    "] execution: " + prioritySnapshot.executionTime.toString());
+        }
+
+        log(Severity::Info, "Dispatcher " + title + " timer lateness: " + snapshot.timerLateness.toString());
+    }
+
+    void InstrumentedDispatcher::PriorityData::itemQueued()
+    {
+        int64_t queued = queuedItemCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        int64_t prevMax = maxQueuedItemCount.load(std::memory_order_relaxed);
+        while (queued > prevMax &&
+               !maxQueuedItemCount.compare_exchange_weak(prevMax, queued, std::memory_order_relaxed)) {
+        }
+    }
+
+    InstrumentedDispatcher::PrioritySnapshot InstrumentedDispatcher::PriorityData::getSnapshot() const
+    {
+        PrioritySnapshot snapshot;
+
+        snapshot.waitTime = waitTime.getSnapshot();
+        snapshot.executionTime = executionTime.getSnapshot();
+        snapshot.queuedItemCount = queuedItemCount.load(std::memory_order_relaxed);
+        snapshot.maxQueuedItemCount = maxQueuedItemCount.load(std::memory_order_relaxed);
+
+        return snapshot;
+    }
+
+    void InstrumentedDispatcher::PriorityData::reset()
+    {
+        waitTime.reset();
+        executionTime.reset();
+
+        maxQueuedItemCount.store(queuedItemCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,104 @@
+#include <bdn/init.h>
+#include <bdn/LatencyHistogram.h>
+
+#include <cstdio>
+
+namespace bdn
+{
+
+    LatencyHistogram::LatencyHistogram() { reset(); }
+
+    void LatencyHistogram::reset()
+    {
+        for (auto &bucket : _buckets)
+            bucket.store(0, std::memory_order_relaxed);
+
+        _count.store(0, std::memory_order_relaxed);
+        _totalNanos.store(0, std::memory_order_relaxed);
+        _maxNanos.store(0, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram::Snapshot LatencyHistogram::getSnapshot() const
+    {
+        Snapshot snapshot;
+
+        snapshot.bucketCounts.reserve(bucketCount);
+        for (auto &bucket : _buckets)
+            snapshot.bucketCounts.push_back(bucket.load(std::memory_order_relaxed));
+
+        snapshot.count = _count.load(std::memory_order_relaxed);
+        snapshot.totalNanos = _totalNanos.load(std::memory_order_relaxed);
+        snapshot.maxNanos = _maxNanos.load(std::memory_order_relaxed);
+
+        return snapshot;
+    }
+
+    int64_t LatencyHistogram::getBucketUpperBound(int bucketIndex)
+    {
+        if (bucketIndex < subBucketCount)
+            return bucketIndex;
+
+        int magnitude = bucketIndex / subBucketCount;
+        int subBucket = bucketIndex % subBucketCount;
+
+        int64_t lowerBound = ((int64_t)(subBucketCount + subBucket)) << (magnitude - 1);
+
+        return lowerBound + (((int64_t)1) << (magnitude - 1)) - 1;
+    }
+
+    String LatencyHistogram::formatNanos(double nanos)
+    {
+        char buffer[32];
+
+        if (nanos < 1000)
+            snprintf(buffer, sizeof(buffer), "%.0fns", nanos);
+        else if (nanos < 1000000)
+            snprintf(buffer, sizeof(buffer), "%.1fus", nanos / 1000);
+        else if (nanos < 1000000000)
+            snprintf(buffer, sizeof(buffer), "%.1fms", nanos / 1000000);
+        else
+            snprintf(buffer, sizeof(buffer), "%.2fs", nanos / 1000000000);
+
+        return buffer;
+    }
+
+    int64_t LatencyHistogram::Snapshot::getPercentileNanos(double percentile) const
+    {
+        // we use the sum of the bucket counts instead of count, since the two
+        // might differ slightly (see LatencyHistogram class documentation).
+        int64_t totalCount = 0;
+        for (int64_t bucketCount : bucketCounts)
+            totalCount += bucketCount;
+
+        if (totalCount == 0)
+            return 0;
+
+        if (percentile < 0)
+            percentile = 0;
+        else if (percentile > 100)
+            percentile = 100;
+
+        int64_t targetCount = (int64_t)(totalCount * percentile / 100 + 0.5);
+        if (targetCount < 1)
+            targetCount = 1;
+
+        int64_t countSoFar = 0;
+        for (int bucketIndex = 0; bucketIndex < (int)bucketCounts.size(); bucketIndex++) {
+            countSoFar += bucketCounts[bucketIndex];
+            if (countSoFar >= targetCount) {
+                int64_t upperBound = getBucketUpperBound(bucketIndex);
+                return (upperBound < maxNanos) ? upperBound : maxNanos;
+            }
+        }
+
+        return maxNanos;
+    }
+
+    String LatencyHistogram::Snapshot::toString() const
+    {
+        return "count=" + std::to_string(count) + " mean=" + formatNanos(getMeanNanos()) +
+               " p50=" + formatNanos((double)getPercentileNanos(50)) +
+               " p90=" + formatNanos((double)getPercentileNanos(90)) +
+               " p99=" + formatNanos((double)getPercentileNanos(99)) + " max=" + formatNanos((double)maxNanos);
+    }
+}
@@ -0,0 +1,89 @@
+#include <bdn/init.h>
+#include <bdn/NotificationBatch.h>
+
+#include <bdn/DanglingFunctionError.h>
+#include <bdn/IDispatcher.h>
+
+namespace bdn
+{
+
+    void NotificationBatch::add(std::function<void()> delivery)
+    {
+        bool scheduleNeeded;
+
+        {
+            FastMutex::Lock lock(_mutex);
+
+            _pending.push_back(std::move(delivery));
+
+            scheduleNeeded = !_deliveryScheduled;
+            _deliveryScheduled = true;
+        }
+
+        // note that we enqueue outside the lock. The dispatcher has its own
+        // mutex and we do not want to nest the two.
+        if (scheduleNeeded)
+            scheduleDelivery();
+    }
+
+    size_t NotificationBatch::getPendingCount() const
+    {
+        FastMutex::Lock lock(_mutex);
+
+        return _pending.size();
+    }
+
+    void NotificationBatch::scheduleDelivery()
+    {
+        P<NotificationBatch> self = this;
+
+        getMainDispatcher()->enqueue([self]() { self->deliver(); });
+    }
+
+    void NotificationBatch::deliver()
+    {
+        std::vector<std::function<void()>> deliveries;
+
+        {
+            FastMutex::Lock lock(_mutex);
+
+            deliveries.swap(_pending);
+
+            // deliveries that are added while we execute the current ones
+            // get a new dispatcher item.
+            _deliveryScheduled = false;
+        }
+
+        for (auto it = deliveries.begin(); it != deliveries.end(); ++it) {
+            try {
+                (*it)();
+            }
+            catch (DanglingFunctionError &) {
+                // ignore, as required for dispatcher items.
+            }
+            catch (...) {
+                // we let the exception propagate to the dispatcher. But the
+                // remaining deliveries must not be lost, so we put them back
+                // in front of the pending list and schedule another
+                // delivery.
+                bool scheduleNeeded;
+
+                {
+                    FastMutex::Lock lock(_mutex);
+
+                    _pending.insert(_pending.begin(), std::make_move_iterator(it + 1),
+                                    std::make_move_iterator(deliveries.end()));
+
+                    scheduleNeeded = !_pending.empty() && !_deliveryScheduled;
+                    if (scheduleNeeded)
+                        _deliveryScheduled = true;
+                }
+
+                if (scheduleNeeded)
+                    scheduleDelivery();
+
+                throw;
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#include <bdn/init.h>
+#include <bdn/PropertyBatch.h>
+
+#include <bdn/PropertyNotificationPhase.h>
+#include <bdn/log.h>
+
+namespace bdn
+{
+
+    BDN_SAFE_STATIC_THREAD_LOCAL_IMPL(PropertyBatch::State, PropertyBatch::getState);
+
+    PropertyBatch::PropertyBatch() { getState().depth++; }
+
+    PropertyBatch::~PropertyBatch()
+    {
+        State &state = getState();
+
+        state.depth--;
+        if (state.depth == 0 && !state.pending.empty())
+            deliver(state);
+    }
+
+    void PropertyBatch::defer(const void *target, int actionCode, std::function<void()> action)
+    {
+        State &state = getState();
+
+        if (state.pendingKeys.insert(std::make_pair(target, actionCode)).second)
+            state.pending.push_back(std::move(action));
+    }
+
+    void PropertyBatch::deliver(State &state)
+    {
+        std::vector<std::function<void()>> actions;
+        actions.swap(state.pending);
+        state.pendingKeys.clear();
+
+        // the whole delivery counts as one notification phase. That way
+        // computed properties are only re-evaluated after all notifications
+        // of the batch have been delivered.
+        PropertyNotificationPhase::enter();
+
+        for (auto &action : actions)
+            BDN_LOG_AND_IGNORE_EXCEPTION(action(), "Error in deferred action of PropertyBatch. Ignoring.");
+
+        BDN_LOG_AND_IGNORE_EXCEPTION(PropertyNotificationPhase::leave(),
+                                     "Error in deferred property notification action. Ignoring.");
+    }
+}
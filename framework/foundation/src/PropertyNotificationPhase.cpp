@@ -0,0 +1,53 @@
+#include <bdn/init.h>
+#include <bdn/PropertyNotificationPhase.h>
+
+namespace bdn
+{
+
+    BDN_SAFE_STATIC_THREAD_LOCAL_IMPL(PropertyNotificationPhase::State, PropertyNotificationPhase::getState);
+
+    void PropertyNotificationPhase::defer(std::function<void()> action)
+    {
+        State &state = getState();
+
+        state.deferred.push_back(std::move(action));
+
+        if (state.depth == 0)
+            runDeferred(state);
+    }
+
+    void PropertyNotificationPhase::runDeferred(State &state)
+    {
+        // we count the execution of the deferred actions as a notification
+        // phase of its own. So notifications that are triggered by the actions
+        // do not start a nested loop - the actions they defer are picked up by
+        // this loop instead.
+        state.depth++;
+
+        try {
+            std::vector<std::function<void()>> actions;
+
+            while (!state.deferred.empty()) {
+                actions.clear();
+                actions.swap(state.deferred);
+
+                for (size_t i = 0; i < actions.size(); i++) {
+                    try {
+                        actions[i]();
+                    }
+                    catch (...) {
+                        // keep the actions that have not been executed yet.
+                        state.deferred.insert(state.deferred.begin(), actions.begin() + i + 1, actions.end());
+                        throw;
+                    }
+                }
+            }
+        }
+        catch (...) {
+            state.depth--;
+            throw;
+        }
+
+        state.depth--;
+    }
+}
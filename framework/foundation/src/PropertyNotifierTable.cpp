@@ -0,0 +1,22 @@
+#include <bdn/init.h>
+#include <bdn/PropertyNotifierTable.h>
+
+#include <cstring>
+
+namespace bdn
+{
+
+    Base *PropertyNotifierTable::findNotifier(const char *propertyName) const
+    {
+        for (const Entry &entry : _entries) {
+            // the property name is usually the same string literal, so we
+            // compare the pointers first. We still have to compare the
+            // contents, since identical literals are not guaranteed to be
+            // merged into one.
+            if (entry.propertyName == propertyName || std::strcmp(entry.propertyName, propertyName) == 0)
+                return entry.notifier.getPtr();
+        }
+
+        return nullptr;
+    }
+}
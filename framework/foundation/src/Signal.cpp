@@ -1,6 +1,10 @@
 #include <bdn/init.h>
 #include <bdn/Signal.h>
 
+#if BDN_HAVE_FUTEX
+#include <bdn/futex.h>
+#endif
+
 namespace bdn
 {
 
@@ -12,7 +16,7 @@ namespace bdn
 
     void Signal::set()
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<MutexType> lock(_mutex);
 
         if (!_signalled) {
             _signalled = true;
@@ -23,13 +27,13 @@ namespace bdn
             // up all threads that are CURRENTLY waiting. For threads that begin
             // to wait later our manual state management with _signalled comes
             // into play.
-            _condition.notify_all();
+            wakeUpAll();
         }
     }
 
     void Signal::clear()
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<MutexType> lock(_mutex);
 
         // simply set _signalled to false. We do not have to do anything with
         // the condition variable because the condition variable has no actual
@@ -42,7 +46,7 @@ namespace bdn
 
     void Signal::pulseOne()
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<MutexType> lock(_mutex);
 
         if (_signalled) {
             // if we are signalled then there can be no one currently waiting.
@@ -65,13 +69,13 @@ namespace bdn
             if (_waitingCount > 0)
                 _pulseOneLeft++;
 
-            _condition.notify_one();
+            wakeUpOne();
         }
     }
 
     void Signal::pulseAll()
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<MutexType> lock(_mutex);
 
         // This is similar to the process in pulseOne. See comments there.
 
@@ -79,7 +83,7 @@ namespace bdn
             _signalled = false;
         else {
             _pulseAllCounter++;
-            _condition.notify_all();
+            wakeUpAll();
         }
     }
 
@@ -89,7 +93,7 @@ namespace bdn
         // signalXYZAndClear calls. So we can ignore those here. We only need to
         // test the persistent _signalled state.
 
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<MutexType> lock(_mutex);
 
         return _signalled;
     }
@@ -105,11 +109,11 @@ namespace bdn
         if (timeoutMillis > 0)
             absoluteTimeoutTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMillis);
 
-        // we must lock the mutex with unique_lock so that the condition
-        // variable can unlock it.
-        std::unique_lock<std::mutex> lock(_mutex);
+        // we must lock the mutex with unique_lock so that waitForWakeUp can
+        // unlock it.
+        std::unique_lock<MutexType> lock(_mutex);
 
-        for (int waitIteration = 0;; waitIteration++) {
+        while (true) {
             if (_signalled) {
                 // we are in persistent signalled state. So return immediately.
                 return true;
@@ -121,30 +125,26 @@ namespace bdn
             {
                 WaitingMarker waitingMarker(this);
 
-                // the wait functions will release the lock while we wait and
-                // then reacquire it before they return.
-                if (timeoutMillis < 0)
-                    _condition.wait(lock);
-                else {
-                    std::cv_status waitResult;
-
-                    if (waitIteration == 0) {
-                        // use wait_for on first iteration to ensure that short
-                        // timeouts do not cause wait to return immediately
-                        // without checking the condition.
-                        waitResult = _condition.wait_for(lock, std::chrono::milliseconds(timeoutMillis));
-                    } else {
-                        // use the absolute timeout time on subsequent
-                        // iterations. If the system clock has been adjusted
-                        // forwards then the timeout will expire "early", but
-                        // that is acceptable.
-                        waitResult = _condition.wait_until<std::chrono::steady_clock>(lock, absoluteTimeoutTime);
-                    }
-
-                    if (waitResult == std::cv_status::timeout) {
-                        // we had a timeout. Signal did not happen.
-                        return false;
-                    }
+                int64_t timeoutNanos = -1;
+                if (timeoutMillis > 0) {
+                    // use the absolute timeout time to calculate the remaining
+                    // wait time. That way spurious wakeups do not extend the
+                    // total wait time.
+                    timeoutNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       absoluteTimeoutTime - std::chrono::steady_clock::now())
+                                       .count();
+
+                    // ensure that short timeouts do not cause wait to return
+                    // immediately without checking the condition.
+                    if (timeoutNanos < 1)
+                        timeoutNanos = 1;
+                }
+
+                // waitForWakeUp will release the lock while we wait and
+                // then reacquire it before it returns.
+                if (!waitForWakeUp(lock, timeoutNanos)) {
+                    // we had a timeout. Signal did not happen.
+                    return false;
                 }
             }
 
@@ -171,4 +171,78 @@ namespace bdn
             // this is a spurious wakeup. Keep waiting.
         }
     }
+
+#if BDN_HAVE_FUTEX
+
+    enum
+    {
+        // number of iterations that a waiting thread spins before it goes to
+        // sleep in the kernel. Signals are often used for very short handoffs
+        // between threads, so the wakeup frequently arrives during this time.
+        signalMaxSpinCount = 100
+    };
+
+    bool Signal::waitForWakeUp(std::unique_lock<MutexType> &lock, int64_t timeoutNanos)
+    {
+        // the sequence number can only change while _mutex is locked. So any
+        // wakeup that happens after we release the lock will be detected.
+        uint32_t sequence = _wakeUpSequence.load(std::memory_order_relaxed);
+
+        lock.unlock();
+
+        bool result = true;
+
+        bool wokenUpWhileSpinning = false;
+        for (int spinCount = 0; spinCount < signalMaxSpinCount; spinCount++) {
+            if (_wakeUpSequence.load(std::memory_order_acquire) != sequence) {
+                wokenUpWhileSpinning = true;
+                break;
+            }
+
+            SpinLock::relaxCpu();
+        }
+
+        if (!wokenUpWhileSpinning)
+            result = futex::wait(_wakeUpSequence, sequence, timeoutNanos);
+
+        lock.lock();
+
+        return result;
+    }
+
+    void Signal::wakeUpOne()
+    {
+        _wakeUpSequence.fetch_add(1, std::memory_order_release);
+
+        // waiting threads register themselves while holding the mutex. So if
+        // nobody is registered then we can avoid the system call.
+        if (_waitingCount > 0)
+            futex::wakeOne(_wakeUpSequence);
+    }
+
+    void Signal::wakeUpAll()
+    {
+        _wakeUpSequence.fetch_add(1, std::memory_order_release);
+
+        if (_waitingCount > 0)
+            futex::wakeAll(_wakeUpSequence);
+    }
+
+#else
+
+    bool Signal::waitForWakeUp(std::unique_lock<MutexType> &lock, int64_t timeoutNanos)
+    {
+        if (timeoutNanos < 0) {
+            _condition.wait(lock);
+            return true;
+        }
+
+        return _condition.wait_for(lock, std::chrono::nanoseconds(timeoutNanos)) != std::cv_status::timeout;
+    }
+
+    void Signal::wakeUpOne() { _condition.notify_one(); }
+
+    void Signal::wakeUpAll() { _condition.notify_all(); }
+
+#endif
 }
@@ -0,0 +1,141 @@
+#include <bdn/init.h>
+#include <bdn/StallWatchdog.h>
+
+#include <bdn/platform/Hooks.h>
+
+#include <cstdio>
+
+#if BDN_HAVE_THREADS
+
+namespace bdn
+{
+
+    namespace
+    {
+        String formatMillis(double seconds)
+        {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "%.0f ms", seconds * 1000);
+            return buffer;
+        }
+    }
+
+    StallWatchdog::StallWatchdog(GenericDispatcher *dispatcher, double budgetSeconds)
+    {
+        if (budgetSeconds <= 0)
+            throw InvalidArgumentError("StallWatchdog must be created with budgetSeconds > 0");
+
+        _dispatcher = dispatcher;
+        _budgetSeconds = budgetSeconds;
+
+        _thread = newObj<Thread>(newObj<Runnable>(this));
+    }
+
+    StallWatchdog::~StallWatchdog() { stop(); }
+
+    void StallWatchdog::stop()
+    {
+        // note that the runnable only has a raw pointer to us. So the thread
+        // must be finished before we are destroyed.
+        if (_thread != nullptr) {
+            _thread->stop(Thread::ExceptionIgnore);
+            _thread = nullptr;
+        }
+    }
+
+    void StallWatchdog::Runnable::run()
+    {
+        // we check four times per budget period, so a stall is detected at
+        // most 25% late. But we do not check more often than every 10 ms.
+        int checkIntervalMillis = (int)(_watchdog->_budgetSeconds * 1000 / 4);
+        if (checkIntervalMillis < 10)
+            checkIntervalMillis = 10;
+
+        while (!shouldStop()) {
+            _wakeUpSignal.wait(checkIntervalMillis);
+
+            if (!shouldStop())
+                _watchdog->check();
+        }
+    }
+
+    void StallWatchdog::check()
+    {
+        GenericDispatcher::Activity activity = _dispatcher->getActivity();
+
+        Mutex::Lock lock(_mutex);
+
+        if (_inStall) {
+            if (activity.executing && activity.itemSequenceNumber == _stallItemSequenceNumber) {
+                // still the same stall. Update the statistics.
+                _statistics.totalStallSeconds += activity.executingSeconds - _stallSeconds;
+                _stallSeconds = activity.executingSeconds;
+
+                if (_stallSeconds > _statistics.maxStallSeconds) {
+                    _statistics.maxStallSeconds = _stallSeconds;
+                    _statistics.maxStallOrigin = _stallOrigin;
+                }
+
+                return;
+            }
+
+            stallEnded();
+        }
+
+        if (activity.executing && activity.executingSeconds > _budgetSeconds) {
+            _inStall = true;
+            _stallItemSequenceNumber = activity.itemSequenceNumber;
+            _stallSeconds = activity.executingSeconds;
+            _stallOrigin = activity.origin.toString();
+
+            _statistics.stallCount++;
+            _statistics.stallCountByOrigin[_stallOrigin]++;
+            _statistics.totalStallSeconds += _stallSeconds;
+
+            if (_stallSeconds > _statistics.maxStallSeconds) {
+                _statistics.maxStallSeconds = _stallSeconds;
+                _statistics.maxStallOrigin = _stallOrigin;
+            }
+
+            platform::Hooks::get()->log(Severity::Error, "Dispatcher stall: item from " + _stallOrigin +
+                                                             " has been executing for " + formatMillis(_stallSeconds) +
+                                                             " (budget: " + formatMillis(_budgetSeconds) + ")");
+        }
+    }
+
+    void StallWatchdog::stallEnded()
+    {
+        // note that we only know the duration up to our last check. So the
+        // actual duration can be up to one check interval longer.
+        platform::Hooks::get()->log(Severity::Info, "Dispatcher stall ended: item from " + _stallOrigin +
+                                                        " executed for at least " + formatMillis(_stallSeconds));
+
+        _inStall = false;
+    }
+
+    StallWatchdog::Statistics StallWatchdog::getStatistics() const
+    {
+        Mutex::Lock lock(_mutex);
+
+        return _statistics;
+    }
+
+    void StallWatchdog::logStatistics() const
+    {
+        Statistics statistics = getStatistics();
+
+        String message = "Dispatcher stall statistics: " + std::to_string(statistics.stallCount) +
+                         " stall(s), total: " + formatMillis(statistics.totalStallSeconds) +
+                         ", longest: " + formatMillis(statistics.maxStallSeconds);
+        if (statistics.stallCount > 0)
+            message += " (" + statistics.maxStallOrigin + ")";
+
+        platform::Hooks::get()->log(Severity::Info, message);
+
+        for (auto &entry : statistics.stallCountByOrigin)
+            platform::Hooks::get()->log(Severity::Info,
+                                        "  " + entry.first + ": " + std::to_string(entry.second) + " stall(s)");
+    }
+}
+
+#endif
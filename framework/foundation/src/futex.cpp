@@ -0,0 +1,53 @@
+#include <bdn/init.h>
+#include <bdn/futex.h>
+
+#if BDN_HAVE_FUTEX
+
+#include <cerrno>
+#include <climits>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace bdn
+{
+    namespace futex
+    {
+
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                      "std::atomic<uint32_t> must have the same layout as a plain 32 bit "
+                      "integer to be used as a futex word.");
+
+        static long futexCall(std::atomic<uint32_t> &word, int op, uint32_t value, const struct timespec *timeout)
+        {
+            // The futex words are only ever shared between threads of the same
+            // process, so we can use the cheaper private variants.
+            return syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), op | FUTEX_PRIVATE_FLAG, value, timeout,
+                           nullptr, 0);
+        }
+
+        bool wait(std::atomic<uint32_t> &word, uint32_t expectedValue, int64_t timeoutNanos)
+        {
+            if (timeoutNanos < 0) {
+                futexCall(word, FUTEX_WAIT, expectedValue, nullptr);
+                return true;
+            }
+
+            struct timespec timeout;
+            timeout.tv_sec = (time_t)(timeoutNanos / 1000000000);
+            timeout.tv_nsec = (long)(timeoutNanos % 1000000000);
+
+            long result = futexCall(word, FUTEX_WAIT, expectedValue, &timeout);
+
+            return !(result == -1 && errno == ETIMEDOUT);
+        }
+
+        void wake(std::atomic<uint32_t> &word, int count) { futexCall(word, FUTEX_WAKE, (uint32_t)count, nullptr); }
+
+        void wakeAll(std::atomic<uint32_t> &word) { wake(word, INT_MAX); }
+    }
+}
+
+#endif
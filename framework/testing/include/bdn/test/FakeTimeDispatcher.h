@@ -0,0 +1,190 @@
+#ifndef BDN_TEST_FakeTimeDispatcher_H_
+#define BDN_TEST_FakeTimeDispatcher_H_
+
+#include <bdn/IDispatcher.h>
+#include <bdn/DanglingFunctionError.h>
+#include <bdn/Mutex.h>
+
+#include <functional>
+#include <map>
+#include <utility>
+
+namespace bdn
+{
+    namespace test
+    {
+
+        /** A dispatcher that uses a simulated clock instead of the real time.
+
+            Nothing is executed on its own. The test controls the time with
+           advanceTime() and executes the items that are due with
+           executeReady(). This makes it possible to test timing dependent code
+           deterministically and without waiting.
+
+            Items with normal priority are executed before idle items. Idle
+           items are only executed when no normal item is due anymore (i.e. at
+           the end of executeReady()).
+
+            Exceptions thrown by the items are propagated to the caller of
+           executeReady() / advanceTime(), except for DanglingFunctionError,
+           which is ignored.
+
+            Items can be enqueued from any thread, but executeReady() and
+           advanceTime() should only be called from the test thread.
+        */
+        class FakeTimeDispatcher : public Base, BDN_IMPLEMENTS IDispatcher
+        {
+          public:
+            FakeTimeDispatcher() {}
+
+            void enqueue(std::function<void()> func, Priority priority = Priority::normal) override
+            {
+                enqueueInSeconds(0, func, priority);
+            }
+
+            void enqueueInSeconds(double seconds, std::function<void()> func,
+                                  Priority priority = Priority::normal) override
+            {
+                Mutex::Lock lock(_mutex);
+
+                double dueTime = _time + (seconds > 0 ? seconds : 0);
+
+                // the sequence number keeps items with the same due time in
+                // the order in which they were enqueued.
+                Key key{dueTime, _nextSequenceNumber++};
+
+                if (priority == Priority::idle)
+                    _idleItems.insert(std::make_pair(key, func));
+                else
+                    _normalItems.insert(std::make_pair(key, func));
+            }
+
+            void createTimer(double intervalSeconds, std::function<bool()> func) override
+            {
+                P<FakeTimeDispatcher> self = this;
+                enqueueInSeconds(intervalSeconds, [self, intervalSeconds, func]() {
+                    bool continueTimer = false;
+
+                    try {
+                        continueTimer = func();
+                    }
+                    catch (DanglingFunctionError &) {
+                        // the timer is stopped
+                    }
+
+                    if (continueTimer)
+                        self->createTimer(intervalSeconds, func);
+                });
+            }
+
+            /** Returns the current simulated time in seconds. The time starts
+               at 0.*/
+            double getTime() const
+            {
+                Mutex::Lock lock(_mutex);
+                return _time;
+            }
+
+            /** Advances the simulated time by the specified number of seconds.
+               Items that become due in the meantime are executed at their due
+               time (i.e. getTime() returns the item's due time while it is
+               executed). Finally, all items that are due at the new time are
+               executed.*/
+            void advanceTime(double seconds)
+            {
+                double targetTime;
+                {
+                    Mutex::Lock lock(_mutex);
+                    targetTime = _time + seconds;
+                }
+
+                while (true) {
+                    executeReady();
+
+                    Mutex::Lock lock(_mutex);
+
+                    double nextDueTime = targetTime;
+                    if (!_normalItems.empty() && _normalItems.begin()->first.dueTime < nextDueTime)
+                        nextDueTime = _normalItems.begin()->first.dueTime;
+                    if (!_idleItems.empty() && _idleItems.begin()->first.dueTime < nextDueTime)
+                        nextDueTime = _idleItems.begin()->first.dueTime;
+
+                    if (nextDueTime <= _time && _time >= targetTime)
+                        break;
+
+                    _time = nextDueTime;
+                }
+            }
+
+            /** Executes all items that are due at the current simulated time,
+               including items that are enqueued by the executed items. Returns
+               the number of executed items.*/
+            int executeReady()
+            {
+                int count = 0;
+
+                while (true) {
+                    std::function<void()> func;
+
+                    {
+                        Mutex::Lock lock(_mutex);
+
+                        if (!takeDueItem(_normalItems, func) && !takeDueItem(_idleItems, func))
+                            break;
+                    }
+
+                    try {
+                        func();
+                    }
+                    catch (DanglingFunctionError &) {
+                        // ignore, as required by IDispatcher.
+                    }
+
+                    count++;
+                }
+
+                return count;
+            }
+
+            /** Returns the number of pending items (due or not).*/
+            size_t getPendingCount() const
+            {
+                Mutex::Lock lock(_mutex);
+                return _normalItems.size() + _idleItems.size();
+            }
+
+          private:
+            struct Key
+            {
+                double dueTime;
+                int64_t sequenceNumber;
+
+                bool operator<(const Key &o) const
+                {
+                    return dueTime < o.dueTime || (dueTime == o.dueTime && sequenceNumber < o.sequenceNumber);
+                }
+            };
+
+            using ItemMap = std::map<Key, std::function<void()>>;
+
+            bool takeDueItem(ItemMap &items, std::function<void()> &func)
+            {
+                if (items.empty() || items.begin()->first.dueTime > _time)
+                    return false;
+
+                func = std::move(items.begin()->second);
+                items.erase(items.begin());
+
+                return true;
+            }
+
+            mutable Mutex _mutex;
+            double _time = 0;
+            int64_t _nextSequenceNumber = 0;
+            ItemMap _normalItems;
+            ItemMap _idleItems;
+        };
+    }
+}
+
+#endif
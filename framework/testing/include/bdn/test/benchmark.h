@@ -0,0 +1,93 @@
+#ifndef BDN_TEST_benchmark_H_
+#define BDN_TEST_benchmark_H_
+
+#include <bdn/Thread.h>
+#include <bdn/Signal.h>
+#include <bdn/Array.h>
+#include <bdn/log.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+namespace bdn
+{
+    namespace test
+    {
+
+        /** Calls \c func \c callCount times and returns the average duration of
+           a single call in nanoseconds.*/
+        template <class FuncType> double measureNanosPerCall(int64_t callCount, FuncType &&func)
+        {
+            auto startTime = std::chrono::steady_clock::now();
+
+            for (int64_t i = 0; i < callCount; i++)
+                func();
+
+            auto duration = std::chrono::steady_clock::now() - startTime;
+
+            return ((double)std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) /
+                   (double)(callCount > 0 ? callCount : 1);
+        }
+
+#if BDN_HAVE_THREADS
+
+        /** Starts \c threadCount threads that each call \c func \c
+           callsPerThread times. The function gets the index of the thread as
+           its parameter. All threads start calling the function at the same
+           time.
+
+            Returns the total wall clock time divided by the total number of
+           calls (i.e. the inverse of the throughput) in nanoseconds.*/
+        template <class FuncType>
+        double measureParallelNanosPerCall(int threadCount, int64_t callsPerThread, FuncType func)
+        {
+            P<Signal> startSignal = newObj<Signal>();
+            std::atomic<int> readyCount(0);
+
+            Array<std::future<void>> futures;
+            for (int threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+                futures.add(Thread::exec([startSignal, &readyCount, &func, threadIndex, callsPerThread]() {
+                    readyCount++;
+                    startSignal->wait();
+
+                    for (int64_t i = 0; i < callsPerThread; i++)
+                        func(threadIndex);
+                }));
+            }
+
+            // wait until all threads are ready so that thread creation is not
+            // included in the measurement.
+            while (readyCount < threadCount)
+                Thread::yield();
+
+            auto startTime = std::chrono::steady_clock::now();
+
+            startSignal->set();
+
+            for (auto &future : futures)
+                future.get();
+
+            auto duration = std::chrono::steady_clock::now() - startTime;
+
+            int64_t totalCallCount = callsPerThread * threadCount;
+
+            return ((double)std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) /
+                   (double)(totalCallCount > 0 ? totalCallCount : 1);
+        }
+
+#endif
+
+        /** Logs the result of a benchmark measurement (see
+         * measureNanosPerCall()).*/
+        inline void logBenchmarkResult(const String &name, double nanosPerCall)
+        {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "%.1f ns", nanosPerCall);
+
+            logInfo("Benchmark " + name + ": " + buffer);
+        }
+    }
+}
+
+#endif
@@ -2952,7 +2952,7 @@ namespace bdn
         }
     };
 
-    class RunContext : public IResultCapture, public IRunner
+    class RunContext : public bdn::Base, public IResultCapture, public IRunner
     {
 
         RunContext(RunContext const &);
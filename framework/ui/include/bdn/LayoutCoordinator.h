@@ -6,6 +6,10 @@
 
 #include <bdn/Set.h>
 
+#include <queue>
+#include <unordered_set>
+#include <vector>
+
 namespace bdn
 {
 
@@ -25,6 +29,15 @@ namespace bdn
         The coordinator also optimizes the order of multiple update operations,
         to ensure that no duplicate work is done.
 
+        All pending operations are performed in a single pass (i.e. in a
+       single item of the main dispatcher). Views are layouted in parent-first
+       order: the pending views are kept in a priority queue that is ordered by
+       their depth in the view tree. The depth is determined once, when the
+       view is registered. Views that need a new layout because of the layout
+       of their parent are merged into the same pass. A view is layouted at most
+       once per pass - if it requests another layout after it has already been
+       layouted in the current pass then that is done in the next pass.
+
         Usually the global coordinator object should be used (see
        LayoutCoordinator::get()).
 
@@ -76,6 +89,15 @@ namespace bdn
 
         void updateNow();
 
+        /** Performs the pending window auto-sizing operations.*/
+        void autoSizeWindows();
+
+        /** Performs the pending layout operations, in parent-first order.*/
+        void layoutViews();
+
+        /** Performs the pending window centering operations.*/
+        void centerWindows();
+
         /** This function is called when an exception occurs during while a
             view is being updated. The default implementation logs the exception
             and does nothing otherwise.
@@ -89,7 +111,36 @@ namespace bdn
             */
         virtual void handleException(const std::exception *exceptionIfAvailable, const String &functionName);
 
-        Set<P<View>> _layoutSet;
+        struct LayoutQueueEntry
+        {
+            int depth;
+
+            // ensures that views with the same depth are layouted in the
+            // order in which they were registered.
+            int64_t order;
+
+            P<View> view;
+
+            bool operator<(const LayoutQueueEntry &o) const
+            {
+                // std::priority_queue returns the largest element first. We
+                // want the smallest depth first.
+                return (depth > o.depth || (depth == o.depth && order > o.order));
+            }
+        };
+
+        std::priority_queue<LayoutQueueEntry> _layoutQueue;
+        int64_t _nextLayoutOrder = 0;
+
+        // the views that are currently in _layoutQueue.
+        std::unordered_set<View *> _pendingLayoutViews;
+
+        // the views that have been layouted in the current pass.
+        std::unordered_set<View *> _layoutedInThisPass;
+
+        // layout requests for views that have already been layouted in the
+        // current pass. These are done in the next pass.
+        std::vector<P<View>> _nextPassLayoutViews;
 
         Set<P<Window>> _windowAutoSizeSet;
         Set<P<Window>> _windowCenterSet;
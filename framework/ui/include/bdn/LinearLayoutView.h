@@ -1,10 +1,22 @@
 #pragma once
 
 #include <bdn/ContainerView.h>
+#include <bdn/LinearLayoutViewTypes.h>
+
+#include <vector>
 
 namespace bdn
 {
 
+    /** Base class for RowView and ColumnView.
+
+        LinearLayoutView caches the results of its last measure and layout
+       pass for each child view. When only some of the children have
+       invalidated their sizing info (see View::getSizingInfoGeneration())
+       then only those children are measured again. The cached bounds of
+       the remaining children are reused - children after a changed child are
+       only moved if the changed child actually changed its size.
+    */
     class LinearLayoutView : public ContainerView
     {
       public:
@@ -25,6 +37,67 @@ namespace bdn
 
         Size calculatePaddedAvailableSpace(const Margin &padding, const Size &effectiveAvailableSpace) const;
 
+        /** The cached result for one child view.*/
+        struct ChildCacheEntry
+        {
+            View *view = nullptr;
+
+            // the sizing info generation of the child at the time the entry
+            // was calculated
+            int64_t sizingInfoGeneration = -1;
+
+            // the parameters of the child that influence its arrangement
+            UiMargin margin;
+            View::HorizontalAlignment horizontalAlignment = View::HorizontalAlignment::left;
+            View::VerticalAlignment verticalAlignment = View::VerticalAlignment::top;
+
+            // primary position before and after the child (including its
+            // margin)
+            double startPrimary = 0;
+            double endPrimary = 0;
+
+            // primary position of the child bounds before they were aligned
+            // to pixel boundaries.
+            double unadjustedPrimary = 0;
+
+            // Measure: the secondary size of the child, including margin.
+            double secondarySizeWithMargin = 0;
+
+            // Layout: the child bounds (before expanding children are
+            // stretched) and the space the child uses if it is not expanding.
+            Rect bounds;
+            bool expand = false;
+            double fixedSpace = 0;
+        };
+
+        struct PassCache
+        {
+            bool valid = false;
+
+            // the parameters of the container that the entries were
+            // calculated with
+            Size space;
+            Margin padding;
+
+            std::vector<ChildCacheEntry> entries;
+        };
+
+        bool canReuseCacheEntry(const ChildCacheEntry &entry, View *childView, int64_t sizingInfoGeneration) const;
+
+        void initCacheEntry(ChildCacheEntry &entry, View *childView, int64_t sizingInfoGeneration) const;
+
+        void measureChild(View *childView, ChildCacheEntry &entry, const VirtualMargin &padding,
+                          const VirtualSize &clippedAvailableSpace) const;
+
+        void layoutChild(View *childView, ChildCacheEntry &entry, const VirtualMargin &padding,
+                         const Size &containerSize, const VirtualSize &paddedAvailableSpace) const;
+
+        /** Moves the cached result of an unchanged child to a new position.*/
+        void moveCacheEntry(View *childView, ChildCacheEntry &entry, double newStartPrimary) const;
+
         bool _horizontal;
+
+        mutable PassCache _measureCache;
+        mutable PassCache _layoutCache;
     };
 }
@@ -14,6 +14,7 @@ namespace bdn
 #include <bdn/Nullable.h>
 #include <bdn/RequireNewAlloc.h>
 #include <bdn/property.h>
+#include <bdn/PropertyBatch.h>
 #include <bdn/mainThread.h>
 #include <bdn/round.h>
 #include <bdn/PreferredViewSizeManager.h>
@@ -21,6 +22,8 @@ namespace bdn
 
 #include <bdn/IViewCore.h>
 
+#include <atomic>
+
 /** \def BDN_VIEW_PROPERTY_WITH_CUSTOM_ACCESS( ValueType, readAccess, name,
    writeAccess, setterName, CoreInterfaceType, modificationInfluenceCalls )
 
@@ -471,6 +474,19 @@ namespace bdn
             */
         virtual void invalidateSizingInfo(InvalidateReason reason);
 
+        /** Returns a number that changes whenever the sizing info of the view
+           is invalidated (see invalidateSizingInfo()).
+
+            Container views can store the generation together with cached
+           measurement results for their children. If the generation of a
+           child has not changed then its cached results are still valid.
+
+            The numbers are unique across all views. So a new view object never
+           has the same generation as an old one, even if it is allocated at
+           the same address.
+            */
+        int64_t getSizingInfoGeneration() const { return _sizingInfoGeneration; }
+
         /** Requests that the view updates the layout of its child view and
            contents.
 
@@ -679,7 +695,9 @@ namespace bdn
             {
                 // update the sizing information. If that changes then the
                 // parent layout will automatically be updated.
-                _view->invalidateSizingInfo(InvalidateReason::standardPropertyChanged);
+                runOrDefer(preferredSizeInfluence_, [](View *view) {
+                    view->invalidateSizingInfo(InvalidateReason::standardPropertyChanged);
+                });
 
                 return *this;
             }
@@ -689,7 +707,8 @@ namespace bdn
             const Influences_ &influencesContentLayout() const
             {
                 // the layout of our children is influenced by this
-                _view->needLayout(InvalidateReason::standardPropertyChanged);
+                runOrDefer(contentLayoutInfluence_,
+                           [](View *view) { view->needLayout(InvalidateReason::standardPropertyChanged); });
 
                 return *this;
             }
@@ -701,9 +720,11 @@ namespace bdn
              margin.*/
             const Influences_ &influencesParentPreferredSize() const
             {
-                P<View> parent = _view->getParentView();
-                if (parent != nullptr)
-                    parent->invalidateSizingInfo(InvalidateReason::standardChildPropertyChanged);
+                runOrDefer(parentPreferredSizeInfluence_, [](View *view) {
+                    P<View> parent = view->getParentView();
+                    if (parent != nullptr)
+                        parent->invalidateSizingInfo(InvalidateReason::standardChildPropertyChanged);
+                });
 
                 return *this;
             }
@@ -716,14 +737,36 @@ namespace bdn
              values.*/
             const Influences_ &influencesParentLayout() const
             {
-                P<View> parent = _view->getParentView();
-                if (parent != nullptr)
-                    parent->needLayout(InvalidateReason::standardChildPropertyChanged);
+                runOrDefer(parentLayoutInfluence_, [](View *view) {
+                    P<View> parent = view->getParentView();
+                    if (parent != nullptr)
+                        parent->needLayout(InvalidateReason::standardChildPropertyChanged);
+                });
 
                 return *this;
             }
 
           private:
+            enum Influence_
+            {
+                preferredSizeInfluence_,
+                contentLayoutInfluence_,
+                parentPreferredSizeInfluence_,
+                parentLayoutInfluence_
+            };
+
+            /** Executes the influence immediately, or queues it if a
+               PropertyBatch is active. Within a batch each influence is only
+               executed once per view.*/
+            void runOrDefer(Influence_ influence, void (*func)(View *)) const
+            {
+                if (PropertyBatch::isActive()) {
+                    P<View> view = _view;
+                    PropertyBatch::defer(_view, influence, [view, func]() { func(view); });
+                } else
+                    func(_view);
+            }
+
             View *_view;
         };
 
@@ -779,6 +822,9 @@ namespace bdn
         P<IViewCore> _core;
 
         mutable PreferredViewSizeManager _preferredSizeManager;
+
+        int64_t _sizingInfoGeneration;
+        static std::atomic<int64_t> _nextSizingInfoGeneration;
     };
 }
 
@@ -1,6 +1,10 @@
 #ifndef BDN_ViewLayout_H_
 #define BDN_ViewLayout_H_
 
+#include <bdn/View.h>
+
+#include <vector>
+
 namespace bdn
 {
 
@@ -10,12 +14,17 @@ namespace bdn
         The "layout" may consist of values for several properties of the view,
        including size and position.
 
+        The bounds of the child views are usually stored with setChildBounds().
+       They are kept in flat arrays that are addressed by the index of the
+       child view in its parent. Storing and applying them does not require
+       any allocations per child view.
+
         Layouts can also contain values for arbitrary custom properties. For
        example, the layout could switch a control into a different mode. To add
        these custom values, one has to subclass ViewLayout::ViewLayoutData and
        extend it to store the additional information. The subclass will have to
        override ViewLayout::ViewLayoutData::applyToView() to update the view
-       accordingly.
+       accordingly. ViewLayoutData objects are set with setViewLayoutData().
 
         */
     class ViewLayout : public Base
@@ -28,13 +37,29 @@ namespace bdn
         */
         virtual void applyTo(View *parentView) const
         {
-            List<P<View>> childList;
-            parentView->getChildViews(childList);
+            for (size_t i = 0; i < _childViews.size(); i++) {
+                if ((_childFlags[i] & boundsSetFlag) == 0)
+                    continue;
+
+                View *childView = _childViews[i];
+
+                // the child might have been removed from the parent after the
+                // layout was calculated.
+                if (childView->getParentView().getPtr() != parentView)
+                    continue;
 
-            for (auto &childView : childList) {
-                P<const ViewLayoutData> data = getViewLayoutData(childView);
-                if (data != nullptr)
-                    data->applyTo(childView);
+                childView->adjustAndSetBounds(_childBounds[i]);
+            }
+
+            if (!_dataMap.empty()) {
+                List<P<View>> childList;
+                parentView->getChildViews(childList);
+
+                for (auto &childView : childList) {
+                    P<const ViewLayoutData> data = getViewLayoutData(childView);
+                    if (data != nullptr)
+                        data->applyTo(childView);
+                }
             }
         }
 
@@ -79,32 +104,102 @@ namespace bdn
             bool _boundsInitialized = false;
         };
 
+        /** Prepares the layout for the specified number of child views.
+            This is optional - it only avoids reallocations.*/
+        void reserveChildren(size_t childCount)
+        {
+            _childViews.reserve(childCount);
+            _childBounds.reserve(childCount);
+            _childFlags.reserve(childCount);
+        }
+
+        /** Sets the bounds of the child view with the specified index (i.e.
+           the position of the child in the list of the parent's child views).
+
+            If the layout already has bounds for the index then they are
+           replaced.*/
+        void setChildBounds(size_t childIndex, View *childView, const Rect &bounds)
+        {
+            if (childIndex >= _childViews.size()) {
+                _childViews.resize(childIndex + 1);
+                _childBounds.resize(childIndex + 1);
+                _childFlags.resize(childIndex + 1, 0);
+            }
+
+            _childViews[childIndex] = childView;
+            _childBounds[childIndex] = bounds;
+            _childFlags[childIndex] |= boundsSetFlag;
+        }
+
+        /** Returns the number of child indices that the layout contains
+           bounds for (see setChildBounds()). Note that some of the indices
+           may not have been set.*/
+        size_t getChildCount() const { return _childViews.size(); }
+
+        /** Returns the child view with the specified index, or null if no
+           bounds were set for the index (see setChildBounds()).*/
+        View *getChildView(size_t childIndex) const
+        {
+            return (childIndex < _childViews.size()) ? _childViews[childIndex].getPtr() : nullptr;
+        }
+
+        /** If bounds were set for the child view with the specified index then
+           they are stored in the bounds parameter and true is returned.
+           Otherwise the bounds parameter is set to a zero rect and false is
+           returned.*/
+        bool getChildBounds(size_t childIndex, Rect &bounds) const
+        {
+            if (childIndex < _childViews.size() && (_childFlags[childIndex] & boundsSetFlag) != 0) {
+                bounds = _childBounds[childIndex];
+                return true;
+            } else {
+                bounds = Rect();
+                return false;
+            }
+        }
+
         /** Sets the layout data for the view. If the layout already has data
-           for the specified view then it is replaced.*/
+           for the specified view then it is replaced.
+
+            Use this for layouts that contain custom properties (see class
+           documentation). For plain bounds setChildBounds() is much more
+           efficient.*/
         void setViewLayoutData(View *view, ViewLayoutData *data) { _dataMap[view] = data; }
 
         /** Returns the layout data for the specified view, or null if no data
-           has been set for the view.*/
-        P<ViewLayoutData> getViewLayoutData(View *view)
-        {
-            auto it = _dataMap.find(view);
-            if (it != _dataMap.end())
-                return it->second;
-            else
-                return nullptr;
-        }
+           has been set for the view.
 
-        P<const ViewLayoutData> getViewLayoutData(View *view) const
+            If only bounds were set for the view with setChildBounds() then a
+           new ViewLayoutData object with these bounds is returned.
+           Modifications of that object do not affect the layout.*/
+        P<ViewLayoutData> getViewLayoutData(View *view) const
         {
             auto it = _dataMap.find(view);
             if (it != _dataMap.end())
                 return it->second;
-            else
-                return nullptr;
+
+            for (size_t i = 0; i < _childViews.size(); i++) {
+                if (_childViews[i] == view && (_childFlags[i] & boundsSetFlag) != 0) {
+                    P<ViewLayoutData> data = newObj<ViewLayoutData>();
+                    data->setBounds(_childBounds[i]);
+                    return data;
+                }
+            }
+
+            return nullptr;
         }
 
       private:
-        Size _size;
+        enum
+        {
+            boundsSetFlag = 1
+        };
+
+        // flat per-child data. The arrays are addressed by the child index.
+        std::vector<P<View>> _childViews;
+        std::vector<Rect> _childBounds;
+        std::vector<uint8_t> _childFlags;
+
         std::map<View *, P<ViewLayoutData>> _dataMap;
     };
 }
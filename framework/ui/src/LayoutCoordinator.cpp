@@ -3,6 +3,7 @@
 
 #include <bdn/NotImplementedError.h>
 #include <bdn/log.h>
+#include <bdn/DispatchOrigin.h>
 
 namespace bdn
 {
@@ -31,7 +32,31 @@ namespace bdn
     {
         Thread::assertInMainThread();
 
-        _layoutSet.insert(view);
+        if (_inUpdateNow && _layoutedInThisPass.count(view) != 0) {
+            // the view has already been layouted in the current pass. Doing it
+            // again right away could cause an endless loop, so we do it in the
+            // next pass.
+            _nextPassLayoutViews.push_back(view);
+            return;
+        }
+
+        if (!_pendingLayoutViews.insert(view).second) {
+            // already in the queue
+            return;
+        }
+
+        // we determine the depth in the view tree only once, here. Note that
+        // if the view is moved to a different parent before it is layouted
+        // then the depth may be outdated. That only affects the order, not
+        // the correctness of the layout.
+        int depth = 0;
+        P<View> currParent = view->getParentView();
+        while (currParent != nullptr) {
+            depth++;
+            currParent = currParent->getParentView();
+        }
+
+        _layoutQueue.push(LayoutQueueEntry{depth, _nextLayoutOrder++, view});
 
         needUpdate();
     }
@@ -40,6 +65,11 @@ namespace bdn
     {
         Thread::assertInMainThread();
 
+        if (_inUpdateNow) {
+            // the running pass will pick up the new request.
+            return;
+        }
+
         if (!_updateScheduled) {
             if (isBeingDeletedBecauseReferenceCountReachedZero()) {
                 // the layout coordinator is in the process of being deleted.
@@ -62,6 +92,7 @@ namespace bdn
             // than run immediately.
             // That is what we want, because that allows us to collect and
             // combine multiple operations.
+            BDN_DISPATCH_ORIGIN_SCOPE();
             asyncCallFromMainThread([self]() {
                 self->_updateScheduled = false;
 
@@ -81,205 +112,120 @@ namespace bdn
         _inUpdateNow = true;
 
         try {
-            // first we have to determine the order in which we should
-            // update the views.
-            // For resizing the optimal order is child-to-parent. Because if
-            // a child's child changes then this might influence the parent's
-            // size. If we would update the parent first and then the child,
-            // then the child update might cause the parent to need another
-            // update afterwards.
-
-            struct ToDo
-            {
-                ToDo() : level(-1) {}
-
-                ToDo(const P<View> &view)
-                {
-                    this->view = view;
-
-                    // find out the view's level inside the UI tree
-                    this->level = 0;
-                    P<View> currParent = view->getParentView();
-                    while (currParent != nullptr) {
-                        this->level++;
-                        currParent = currParent->getParentView();
-                    }
-                }
+            // Window auto-sizing can cause layout requests for the window
+            // contents, and layouts can cause windows to be auto-sized
+            // again. So we repeat until no more work is pending. Window
+            // centering is done last, since it depends on the final window
+            // size.
+            while (true) {
+                autoSizeWindows();
 
-                bool operator<(const ToDo &o) const
-                {
-                    return (level < o.level || (level == o.level && view.getPtr() < o.view.getPtr()));
-                }
+                layoutViews();
 
-                P<View> view;
-                int level;
-            };
-
-            // now we do window auto sizing
-            bool anyWindowsAutoSized = false;
-            {
-                // note that the order in which we auto-size the windows
-                // does not matter, since all windows are top-level
-
-                Set<P<Window>> toDoSet;
-                while (true) {
-                    toDoSet.insert(_windowAutoSizeSet.begin(), _windowAutoSizeSet.end());
-                    _windowAutoSizeSet.clear();
-
-                    if (toDoSet.empty()) {
-                        // done.
-                        break;
-                    }
-
-                    P<Window> window = *toDoSet.begin();
-                    toDoSet.erase(toDoSet.begin());
-
-                    anyWindowsAutoSized = true;
-
-                    P<IWindowCoreExtension> core = tryCast<IWindowCoreExtension>(window->getViewCore());
-                    if (core != nullptr) {
-                        try {
-                            core->autoSize();
-                        }
-                        catch (std::exception &e) {
-                            handleException(&e, "LayoutCoordinator::"
-                                                "IWindowCoreExtension::autoSize");
-                        }
-                        catch (...) {
-                            handleException(nullptr, "LayoutCoordinator::"
-                                                     "IWindowCoreExtension::autoSize");
-                        }
-                    }
-                }
-            }
+                if (!_windowAutoSizeSet.empty())
+                    continue;
 
-            // note that for window sizing we also need to do the same async
-            // interruption here that we do after sizing info updates. While
-            // window sizes cannot impact parents, they CAN cause layout
-            // operations of inner windows. And we do want all of those to be in
-            // our queues, so that we can remove duplicates.
-            // So again, we reschedule another update if we have done anything.
-            if (anyWindowsAutoSized)
-                needUpdate();
-            else {
-                bool anyLayoutDone = false;
-
-                // now do the layout operations.
-                // Note that layout operations that have been triggered by any
-                // of the sizing info updates, or window auto-sizing are
-                // included in this!
-                {
-                    ToDo nextToDo;
-
-                    {
-                        Set<P<View>> layoutSetCopy;
-
-                        {
-                            layoutSetCopy = _layoutSet;
-                        }
-
-                        {
-                            // note that we only remove one view at a time from
-                            // the pending set. The reason is that we need to
-                            // handle pending events after each layout. So we
-                            // select the one we want (parent first order) and
-                            // leave the others in the set for now.
-
-                            for (auto &view : layoutSetCopy) {
-                                // construct ToDo object so that we know the
-                                // level.
-                                ToDo toDo(view);
-
-                                if (nextToDo.view == nullptr || toDo < nextToDo)
-                                    nextToDo = toDo;
-                            }
-                        }
-                    }
-
-                    if (nextToDo.view != nullptr) {
-                        // remove the view we selected from the set
-                        _layoutSet.erase(nextToDo.view);
-                    }
-
-                    if (nextToDo.view != nullptr) {
-                        anyLayoutDone = true;
-
-                        try {
-                            P<IViewCoreExtension> core = tryCast<IViewCoreExtension>(nextToDo.view->getViewCore());
-                            if (core != nullptr)
-                                core->layout();
-                        }
-                        catch (std::exception &e) {
-                            handleException(&e, "LayoutCoordinator::"
-                                                "IViewCoreExtension::layout");
-                        }
-                        catch (...) {
-                            handleException(nullptr, "LayoutCoordinator::"
-                                                     "IViewCoreExtension::layout");
-                        }
-                    }
-                }
+                centerWindows();
 
-                // if a parent view has been layouted then we want events to be
-                // handled at this point, before we continue with our todo list
-                // (which is in parent-first order). The reason is that child
-                // sizes may have changed and the property change notifications
-                // for those changes are queued up in the dispatcher queue now
-                // (if child sizes changed). And those queued up change
-                // notifications will likely trigger a layout request for the
-                // child view they belong to. And since the child view might
-                // already be in our todo list it is important that we wait for
-                // the queued up events to be handled before we proceed with the
-                // layout. Only if we wait can we detect the duplicate layout
-                // and prevent the child from being layouted twice. So if we did
-                // layout anything then we schedule another update. Otherwise we
-                // continue.
-                if (anyLayoutDone)
-                    needUpdate();
-                else {
-                    // now we do window centering
-                    {
-                        // note that the order in which we auto-size the windows
-                        // does not matter, since all windows are top-level
-
-                        Set<P<Window>> toDoSet;
-                        while (true) {
-                            toDoSet.insert(_windowCenterSet.begin(), _windowCenterSet.end());
-                            _windowCenterSet.clear();
-
-                            if (toDoSet.empty()) {
-                                // done.
-                                break;
-                            }
-
-                            P<Window> window = *toDoSet.begin();
-                            toDoSet.erase(toDoSet.begin());
-
-                            P<IWindowCoreExtension> core = tryCast<IWindowCoreExtension>(window->getViewCore());
-                            if (core != nullptr) {
-                                try {
-                                    core->center();
-                                }
-                                catch (std::exception &e) {
-                                    handleException(&e, "LayoutCoordinator::"
-                                                        "IWindowCoreExtension::center");
-                                }
-                                catch (...) {
-                                    handleException(nullptr, "LayoutCoordinator::"
-                                                             "IWindowCoreExtension::center");
-                                }
-                            }
-                        }
-                    }
-                }
+                if (_windowAutoSizeSet.empty() && _layoutQueue.empty())
+                    break;
             }
         }
         catch (...) {
             _inUpdateNow = false;
+            _layoutedInThisPass.clear();
             throw;
         }
 
         _inUpdateNow = false;
+        _layoutedInThisPass.clear();
+
+        if (!_nextPassLayoutViews.empty()) {
+            std::vector<P<View>> nextPassViews;
+            nextPassViews.swap(_nextPassLayoutViews);
+
+            for (auto &view : nextPassViews)
+                viewNeedsLayout(view);
+        }
+    }
+
+    void LayoutCoordinator::autoSizeWindows()
+    {
+        // note that the order in which we auto-size the windows
+        // does not matter, since all windows are top-level
+        while (!_windowAutoSizeSet.empty()) {
+            P<Window> window = *_windowAutoSizeSet.begin();
+            _windowAutoSizeSet.erase(_windowAutoSizeSet.begin());
+
+            P<IWindowCoreExtension> core = tryCast<IWindowCoreExtension>(window->getViewCore());
+            if (core != nullptr) {
+                try {
+                    core->autoSize();
+                }
+                catch (std::exception &e) {
+                    handleException(&e, "LayoutCoordinator::"
+                                        "IWindowCoreExtension::autoSize");
+                }
+                catch (...) {
+                    handleException(nullptr, "LayoutCoordinator::"
+                                             "IWindowCoreExtension::autoSize");
+                }
+            }
+        }
+    }
+
+    void LayoutCoordinator::layoutViews()
+    {
+        // For layout the optimal order is parent-to-child, since the layout
+        // of the parent can change the size of its children (which causes
+        // them to need a new layout). Views that are registered while we
+        // are in this loop are added to the queue and are picked up in the
+        // correct order. If they are already in the queue then the duplicate
+        // is detected, so each view is only layouted once.
+        while (!_layoutQueue.empty()) {
+            P<View> view = _layoutQueue.top().view;
+            _layoutQueue.pop();
+
+            _pendingLayoutViews.erase(view.getPtr());
+            _layoutedInThisPass.insert(view.getPtr());
+
+            try {
+                P<IViewCoreExtension> core = tryCast<IViewCoreExtension>(view->getViewCore());
+                if (core != nullptr)
+                    core->layout();
+            }
+            catch (std::exception &e) {
+                handleException(&e, "LayoutCoordinator::"
+                                    "IViewCoreExtension::layout");
+            }
+            catch (...) {
+                handleException(nullptr, "LayoutCoordinator::"
+                                         "IViewCoreExtension::layout");
+            }
+        }
+    }
+
+    void LayoutCoordinator::centerWindows()
+    {
+        while (!_windowCenterSet.empty()) {
+            P<Window> window = *_windowCenterSet.begin();
+            _windowCenterSet.erase(_windowCenterSet.begin());
+
+            P<IWindowCoreExtension> core = tryCast<IWindowCoreExtension>(window->getViewCore());
+            if (core != nullptr) {
+                try {
+                    core->center();
+                }
+                catch (std::exception &e) {
+                    handleException(&e, "LayoutCoordinator::"
+                                        "IWindowCoreExtension::center");
+                }
+                catch (...) {
+                    handleException(nullptr, "LayoutCoordinator::"
+                                             "IWindowCoreExtension::center");
+                }
+            }
+        }
     }
 
     void LayoutCoordinator::handleException(const std::exception *exceptionIfAvailable, const String &functionName)
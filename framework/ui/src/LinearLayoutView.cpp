@@ -72,6 +72,46 @@ namespace bdn
         return result;
     }
 
+    bool LinearLayoutView::canReuseCacheEntry(const ChildCacheEntry &entry, View *childView,
+                                              int64_t sizingInfoGeneration) const
+    {
+        return (entry.view == childView && entry.sizingInfoGeneration == sizingInfoGeneration &&
+                entry.margin == childView->margin() && entry.horizontalAlignment == childView->horizontalAlignment() &&
+                entry.verticalAlignment == childView->verticalAlignment());
+    }
+
+    void LinearLayoutView::initCacheEntry(ChildCacheEntry &entry, View *childView, int64_t sizingInfoGeneration) const
+    {
+        entry.view = childView;
+        entry.sizingInfoGeneration = sizingInfoGeneration;
+        entry.margin = childView->margin();
+        entry.horizontalAlignment = childView->horizontalAlignment();
+        entry.verticalAlignment = childView->verticalAlignment();
+    }
+
+    void LinearLayoutView::measureChild(View *childView, ChildCacheEntry &entry, const VirtualMargin &padding,
+                                        const VirtualSize &clippedAvailableSpace) const
+    {
+        const VirtualMargin childMargin(_horizontal, childView->uiMarginToDipMargin(entry.margin));
+
+        VirtualPoint childPosition(_horizontal, entry.startPrimary + childMargin.primaryNear,
+                                   padding.secondaryNear + childMargin.secondaryNear);
+
+        entry.unadjustedPrimary = childPosition.primary;
+
+        AdjustedChildBoundsResult adj = calculateAdjustedChildBounds(
+            _horizontal, childView, childPosition, childMargin, clippedAvailableSpace, LayoutPhase::Measure);
+
+        VirtualRect adjustedChildBounds(_horizontal, adj.bounds);
+
+        entry.bounds = adj.bounds;
+
+        VirtualSize childSizeWithMargin(_horizontal, (adjustedChildBounds.toRect() + childMargin.toMargin()).getSize());
+
+        entry.secondarySizeWithMargin = childSizeWithMargin.secondary;
+        entry.endPrimary = adjustedChildBounds.primary + adjustedChildBounds.primarySize + childMargin.primaryFar;
+    }
+
     Size LinearLayoutView::calcContainerPreferredSize(const Size &availableSpace /*= Size::none()*/) const
     {
         VirtualMargin padding(_horizontal, calculatePadding());
@@ -82,52 +122,52 @@ namespace bdn
 
         clippedAvailableSpace.applyMaximum(preferredSizeMaximum());
 
-        // Subtract row view padding, ensure non-negative size
-        VirtualSize paddedAvailableSpace(
-            _horizontal, calculatePaddedAvailableSpace(padding.toMargin(), clippedAvailableSpace.toSize()));
+        // the cached results can only be reused if they were calculated with
+        // the same parameters.
+        if (!_measureCache.valid || _measureCache.space != clippedAvailableSpace.toSize() ||
+            _measureCache.padding != padding.toMargin()) {
+            _measureCache.entries.clear();
+            _measureCache.space = clippedAvailableSpace.toSize();
+            _measureCache.padding = padding.toMargin();
+        }
+        _measureCache.valid = false;
+
+        std::vector<ChildCacheEntry> &entries = _measureCache.entries;
+        entries.resize(_childViews.size());
 
-        VirtualPoint childPosition(_horizontal, padding.primaryNear, .0);
+        double childPrimaryPosition = padding.primaryNear;
 
         // Used to calculate preferred size in case available height is
         // infinite. Otherwise paddedAvailableSpace.height is used to calculate
         // row view's preferred height.
         double maxChildSecondarySizeWithMargin = 0.;
 
-        List<P<View>> childViews;
-        getChildViews(childViews);
-
-        for (const auto &childView : childViews) {
-            const VirtualMargin childMargin(_horizontal, childView->uiMarginToDipMargin(childView->margin()));
-
-            childPosition.primary += childMargin.primaryNear;
-            childPosition.secondary = padding.secondaryNear + childMargin.secondaryNear;
-
-            AdjustedChildBoundsResult adj = calculateAdjustedChildBounds(
-                _horizontal, childView, childPosition, childMargin, clippedAvailableSpace, LayoutPhase::Measure);
+        size_t index = 0;
+        for (const auto &childView : _childViews) {
+            ChildCacheEntry &entry = entries[index++];
 
-            // Adjust bounds to clipped available space
-            VirtualRect adjustedChildBounds(_horizontal, adj.bounds);
+            int64_t sizingInfoGeneration = childView->getSizingInfoGeneration();
 
-            // Increase LinearLayoutView's height if adjusted bounds exceed
-            // padded available space; only applies if
-            // clippedAvailableSpace.height is finite
-            VirtualSize childSizeWithMargin(_horizontal,
-                                            (adjustedChildBounds.toRect() + childMargin.toMargin()).getSize());
-
-            if (std::isfinite(clippedAvailableSpace.secondary) &&
-                childSizeWithMargin.secondary - paddedAvailableSpace.secondary > 0.01) {
-                paddedAvailableSpace.secondary = childSizeWithMargin.secondary;
+            if (canReuseCacheEntry(entry, childView, sizingInfoGeneration)) {
+                // the child has not changed. Only its position can be
+                // different, if a previous child changed its size.
+                if (childPrimaryPosition != entry.startPrimary)
+                    moveCacheEntry(childView, entry, childPrimaryPosition);
+            } else {
+                initCacheEntry(entry, childView, sizingInfoGeneration);
+                entry.startPrimary = childPrimaryPosition;
+                measureChild(childView, entry, padding, clippedAvailableSpace);
             }
 
-            if (childSizeWithMargin.secondary > maxChildSecondarySizeWithMargin) {
-                maxChildSecondarySizeWithMargin = childSizeWithMargin.secondary;
-            }
+            if (entry.secondarySizeWithMargin > maxChildSecondarySizeWithMargin)
+                maxChildSecondarySizeWithMargin = entry.secondarySizeWithMargin;
 
-            childPosition.primary =
-                adjustedChildBounds.primary + adjustedChildBounds.primarySize + childMargin.primaryFar;
+            childPrimaryPosition = entry.endPrimary;
         }
 
-        VirtualSize preferredSize(_horizontal, childPosition.primary + padding.primaryFar,
+        _measureCache.valid = true;
+
+        VirtualSize preferredSize(_horizontal, childPrimaryPosition + padding.primaryFar,
                                   maxChildSecondarySizeWithMargin + padding.secondaryNear + padding.secondaryFar);
 
         preferredSize.applyMinimum(preferredSizeMinimum());
@@ -136,122 +176,190 @@ namespace bdn
         return preferredSize.toSize();
     }
 
-    P<ViewLayout> LinearLayoutView::calcContainerLayout(const Size &containerSize) const
+    void LinearLayoutView::layoutChild(View *childView, ChildCacheEntry &entry, const VirtualMargin &padding,
+                                       const Size &containerSize, const VirtualSize &paddedAvailableSpace) const
     {
-        if (!std::isfinite(containerSize.width) || !std::isfinite(containerSize.height))
-            throw InvalidArgumentError("The containerSize argument must represent a finite size "
-                                       "during the layout phase.");
-
-        auto layout = newObj<ViewLayout>();
+        const VirtualMargin childMargin(_horizontal, childView->uiMarginToDipMargin(entry.margin));
 
         VirtualSize virtualContainerSize(_horizontal, containerSize);
 
-        VirtualMargin padding(_horizontal, calculatePadding());
+        VirtualPoint childPosition(_horizontal, entry.startPrimary + childMargin.primaryNear,
+                                   padding.secondaryNear + childMargin.secondaryNear);
 
-        // Subtract row view padding, ensure non-negative size
-        VirtualSize paddedAvailableSpace(_horizontal, calculatePaddedAvailableSpace(padding.toMargin(), containerSize));
+        entry.unadjustedPrimary = childPosition.primary;
 
-        VirtualPoint childPosition(_horizontal, padding.primaryNear, .0);
+        // Adjust bounds to pre-calculated container size. Note: in the
+        // layout phase, child bounds cannot exceed container size, but
+        // adjustBounds() may still round sizes yielding small overflows.
 
-        List<P<View>> childViews;
-        getChildViews(childViews);
+        AdjustedChildBoundsResult adj =
+            calculateAdjustedChildBounds(_horizontal, childView, childPosition, childMargin,
+                                         VirtualSize(_horizontal, containerSize), LayoutPhase::Layout);
 
-        bool hasExpandingChildren = false;
-        double fullExpansion = 0.0;
-        double fixedSpaceUsed = 0.0;
+        VirtualRect adjustedChildBounds(_horizontal, adj.bounds);
+        VirtualRect unadjustedChildBounds(_horizontal, adj.unadjustedBounds);
+        VirtualSize childSize(_horizontal, adj.childSize);
 
-        for (const auto &childView : childViews) {
-            const VirtualMargin childMargin(_horizontal, childView->uiMarginToDipMargin(childView->margin()));
+        entry.bounds = adjustedChildBounds.toRect();
 
-            childPosition.primary += childMargin.primaryNear;
-            childPosition.secondary = padding.secondaryNear + childMargin.secondaryNear;
+        // Round down LinearLayoutView's height if child bounds exceed
+        // padded available space due to rounding up in prior call to
+        // adjustBounds()
+        const VirtualSize childSizeWithMargin = (adjustedChildBounds + childMargin).getSize();
 
-            // Adjust bounds to pre-calculated container size. Note: in the
-            // layout phase, child bounds cannot exceed container size, but
-            // adjustBounds() may still round sizes yielding small overflows.
+        if (std::isfinite(virtualContainerSize.secondary) &&
+            (childSizeWithMargin.secondary - paddedAvailableSpace.secondary > 0.01)) {
+            adjustedChildBounds =
+                VirtualRect(_horizontal, childView->adjustBounds(adj.unadjustedBounds, RoundType::up, RoundType::down));
+        }
 
-            AdjustedChildBoundsResult adj =
-                calculateAdjustedChildBounds(_horizontal, childView, childPosition, childMargin,
-                                             VirtualSize(_horizontal, containerSize), LayoutPhase::Layout);
+        // Recalculate and reajust to preferred child width if the previous
+        // adjustment has changed the child's height
+        if (fabs(adjustedChildBounds.secondarySize - unadjustedChildBounds.secondarySize) > 0.01 &&
+            (adjustedChildBounds.secondarySize < childSize.secondary)) {
 
-            VirtualRect adjustedChildBounds(_horizontal, adj.bounds);
-            VirtualRect unadjustedChildBounds(_horizontal, adj.unadjustedBounds);
-            VirtualSize childSize(_horizontal, adj.childSize);
+            VirtualSize inSize(_horizontal, Size::componentNone(), adjustedChildBounds.primarySize);
 
-            auto childLayoutData = newObj<ViewLayout::ViewLayoutData>();
-            childLayoutData->setBounds(adjustedChildBounds.toRect());
-            layout->setViewLayoutData(childView, childLayoutData);
+            VirtualSize newSize(_horizontal, childView->calcPreferredSize(inSize.toSize()));
 
-            // Round down LinearLayoutView's height if child bounds exceed
-            // padded available space due to rounding up in prior call to
-            // adjustBounds()
-            const VirtualSize childSizeWithMargin = (adjustedChildBounds + childMargin).getSize();
+            if (newSize.primary != adjustedChildBounds.primarySize) {
+                adjustedChildBounds.primarySize = newSize.primary;
 
-            if (std::isfinite(virtualContainerSize.secondary) &&
-                (childSizeWithMargin.secondary - paddedAvailableSpace.secondary > 0.01)) {
+                // Readjust bounds to new width
                 adjustedChildBounds = VirtualRect(
-                    _horizontal, childView->adjustBounds(adj.unadjustedBounds, RoundType::up, RoundType::down));
+                    _horizontal, childView->adjustBounds(adjustedChildBounds.toRect(), RoundType::up, RoundType::down));
             }
+        }
 
-            // Recalculate and reajust to preferred child width if the previous
-            // adjustment has changed the child's height
-            if (fabs(adjustedChildBounds.secondarySize - unadjustedChildBounds.secondarySize) > 0.01 &&
-                (adjustedChildBounds.secondarySize < childSize.secondary)) {
+        entry.endPrimary = adjustedChildBounds.primary + adjustedChildBounds.primarySize + childMargin.primaryFar;
 
-                VirtualSize inSize(_horizontal, Size::componentNone(), adjustedChildBounds.primarySize);
+        entry.expand = (primaryToVirtualAlignment(_horizontal, childView) == VirtualAlignment::expand);
+        entry.fixedSpace = entry.expand ? 0. : (entry.endPrimary - entry.unadjustedPrimary);
+    }
 
-                VirtualSize newSize(_horizontal, childView->calcPreferredSize(inSize.toSize()));
+    void LinearLayoutView::moveCacheEntry(View *childView, ChildCacheEntry &entry, double newStartPrimary) const
+    {
+        double shift = newStartPrimary - entry.startPrimary;
 
-                if (newSize.primary != adjustedChildBounds.primarySize) {
-                    adjustedChildBounds.primarySize = newSize.primary;
+        entry.startPrimary = newStartPrimary;
+        entry.unadjustedPrimary += shift;
 
-                    // Readjust bounds to new width
-                    adjustedChildBounds =
-                        VirtualRect(_horizontal, childView->adjustBounds(adjustedChildBounds.toRect(), RoundType::up,
-                                                                         RoundType::down));
-                }
-            }
+        // Position and size of the child bounds are aligned independently. So
+        // we only need to align the new position. Note that we cannot simply
+        // add the shift to the adjusted position, since the shift is not
+        // necessarily aligned to a pixel boundary.
+        VirtualRect unadjustedBounds(_horizontal, Rect());
+        unadjustedBounds.primary = entry.unadjustedPrimary;
 
-            double lastPos = childPosition.primary;
+        double newPrimary =
+            VirtualRect(_horizontal, childView->adjustBounds(unadjustedBounds.toRect(), RoundType::up, RoundType::up))
+                .primary;
 
-            childPosition.primary =
-                adjustedChildBounds.primary + adjustedChildBounds.primarySize + childMargin.primaryFar;
+        VirtualRect bounds(_horizontal, entry.bounds);
+        double delta = newPrimary - bounds.primary;
 
-            if (primaryToVirtualAlignment(_horizontal, childView) == VirtualAlignment::expand) {
-                fullExpansion += 1.0; // No growth factor yet
-                hasExpandingChildren = true;
+        bounds.primary = newPrimary;
+        entry.bounds = bounds.toRect();
+
+        entry.endPrimary += delta;
+        if (!entry.expand)
+            entry.fixedSpace = entry.endPrimary - entry.unadjustedPrimary;
+    }
+
+    P<ViewLayout> LinearLayoutView::calcContainerLayout(const Size &containerSize) const
+    {
+        if (!std::isfinite(containerSize.width) || !std::isfinite(containerSize.height))
+            throw InvalidArgumentError("The containerSize argument must represent a finite size "
+                                       "during the layout phase.");
+
+        auto layout = newObj<ViewLayout>();
+
+        VirtualSize virtualContainerSize(_horizontal, containerSize);
+
+        VirtualMargin padding(_horizontal, calculatePadding());
+
+        // Subtract row view padding, ensure non-negative size
+        VirtualSize paddedAvailableSpace(_horizontal, calculatePaddedAvailableSpace(padding.toMargin(), containerSize));
+
+        if (!_layoutCache.valid || _layoutCache.space != containerSize || _layoutCache.padding != padding.toMargin()) {
+            _layoutCache.entries.clear();
+            _layoutCache.space = containerSize;
+            _layoutCache.padding = padding.toMargin();
+        }
+        _layoutCache.valid = false;
+
+        std::vector<ChildCacheEntry> &entries = _layoutCache.entries;
+        entries.resize(_childViews.size());
+
+        double childPrimaryPosition = padding.primaryNear;
+
+        bool hasExpandingChildren = false;
+        double fullExpansion = 0.0;
+        double fixedSpaceUsed = 0.0;
+
+        size_t index = 0;
+        for (const auto &childView : _childViews) {
+            ChildCacheEntry &entry = entries[index++];
+
+            int64_t sizingInfoGeneration = childView->getSizingInfoGeneration();
+
+            if (canReuseCacheEntry(entry, childView, sizingInfoGeneration)) {
+                // the child has not changed. If a previous child has changed
+                // its size then we only need to move it - there is no need
+                // to measure it again.
+                if (childPrimaryPosition != entry.startPrimary)
+                    moveCacheEntry(childView, entry, childPrimaryPosition);
             } else {
-                fixedSpaceUsed += (childPosition.primary - lastPos);
+                initCacheEntry(entry, childView, sizingInfoGeneration);
+                entry.startPrimary = childPrimaryPosition;
+                layoutChild(childView, entry, padding, containerSize, paddedAvailableSpace);
             }
+
+            if (entry.expand) {
+                fullExpansion += 1.0; // No growth factor yet
+                hasExpandingChildren = true;
+            } else
+                fixedSpaceUsed += entry.fixedSpace;
+
+            childPrimaryPosition = entry.endPrimary;
         }
 
+        _layoutCache.valid = true;
+
+        double factor = 0.0;
+        bool expandChildren = false;
         if (hasExpandingChildren) {
             double emptySpace = virtualContainerSize.primary - fixedSpaceUsed;
             if (emptySpace > 0.01) {
-                double factor = emptySpace / fullExpansion;
-
-                double push = 0.0;
+                factor = emptySpace / fullExpansion;
+                expandChildren = true;
+            }
+        }
 
-                for (const auto &childView : childViews) {
-                    P<ViewLayout::ViewLayoutData> childLayout = layout->getViewLayoutData(childView);
-                    Rect childBounds;
-                    childLayout->getBounds(childBounds);
+        double push = 0.0;
 
-                    VirtualRect bounds(_horizontal, childBounds);
+        layout->reserveChildren(entries.size());
 
-                    bounds.primary += push;
+        index = 0;
+        for (const auto &childView : _childViews) {
+            const ChildCacheEntry &entry = entries[index];
 
-                    if (primaryToVirtualAlignment(_horizontal, childView) == VirtualAlignment::expand) {
-                        double oldSize = bounds.primarySize;
-                        bounds.primarySize = factor; // * growFactor
-                        push += (bounds.primarySize - oldSize);
+            if (expandChildren) {
+                VirtualRect bounds(_horizontal, entry.bounds);
 
-                    } else {
-                    }
+                bounds.primary += push;
 
-                    childLayout->setBounds(bounds.toRect());
+                if (entry.expand) {
+                    double oldSize = bounds.primarySize;
+                    bounds.primarySize = factor; // * growFactor
+                    push += (bounds.primarySize - oldSize);
                 }
-            }
+
+                layout->setChildBounds(index, childView, bounds.toRect());
+            } else
+                layout->setChildBounds(index, childView, entry.bounds);
+
+            index++;
         }
 
         return layout;
@@ -7,7 +7,9 @@
 namespace bdn
 {
 
-    View::View()
+    std::atomic<int64_t> View::_nextSizingInfoGeneration(1);
+
+    View::View() : _sizingInfoGeneration(_nextSizingInfoGeneration++)
     {
         setVisible(true); // most views are initially visible
         setPreferredSizeHint(Size::none());
@@ -153,6 +155,8 @@ namespace bdn
         // clear cached sizing data
         _preferredSizeManager.clear();
 
+        _sizingInfoGeneration = _nextSizingInfoGeneration++;
+
         // pass the operation to the core. The core will take care
         // of invalidating the layout, if necessary
         P<IViewCore> core = getViewCore();
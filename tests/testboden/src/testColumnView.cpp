@@ -3,9 +3,12 @@
 
 #include <bdn/ColumnView.h>
 #include <bdn/Button.h>
+#include <bdn/Window.h>
+#include <bdn/Dip.h>
 #include <bdn/test/testView.h>
 #include <bdn/test/MockViewCore.h>
 #include <bdn/test/MockContainerViewCore.h>
+#include <bdn/test/MockUiProvider.h>
 
 using namespace bdn;
 
@@ -395,3 +398,95 @@ SECTION("multiple child views properly arranged")
 }
 }
 }
+
+class MeasureCountingButton : public Button
+{
+  public:
+    Size calcPreferredSize(const Size &availableSpace = Size::none()) const override
+    {
+        measureCount++;
+        return Button::calcPreferredSize(availableSpace);
+    }
+
+    mutable int measureCount = 0;
+};
+
+TEST_CASE("ColumnView-incremental")
+{
+    P<bdn::test::MockUiProvider> uiProvider = newObj<bdn::test::MockUiProvider>();
+    P<Window> window = newObj<Window>(uiProvider);
+
+    P<ColumnView> columnView = newObj<ColumnView>();
+    window->setContentView(columnView);
+
+    P<Array<P<MeasureCountingButton>>> buttons = newObj<Array<P<MeasureCountingButton>>>();
+    for (int i = 0; i < 500; i++) {
+        P<MeasureCountingButton> button = newObj<MeasureCountingButton>();
+        button->setLabel("Button");
+        columnView->addChildView(button);
+        buttons->add(button);
+    }
+
+    CONTINUE_SECTION_WHEN_IDLE(window, columnView, buttons)
+    {
+        Array<Point> positionsBefore;
+        for (auto &button : *buttons) {
+            button->measureCount = 0;
+            positionsBefore.add(button->position());
+        }
+
+        SECTION("only changed child is measured")
+        {
+            // a shorter label does not change the size of the column
+            (*buttons)[250]->setLabel("B");
+
+            CONTINUE_SECTION_WHEN_IDLE(window, columnView, buttons, positionsBefore)
+            {
+                for (size_t i = 0; i < buttons->size(); i++) {
+                    P<MeasureCountingButton> button = (*buttons)[i];
+
+                    if (i == 250)
+                        REQUIRE(button->measureCount > 0);
+                    else
+                        REQUIRE(button->measureCount == 0);
+
+                    // the height of the child did not change, so no child was
+                    // moved.
+                    REQUIRE(button->position() == positionsBefore[i]);
+                }
+            };
+        }
+
+        SECTION("following children are moved")
+        {
+            (*buttons)[250]->setMargin(UiMargin(UiLength::sem(1), UiLength(), UiLength::sem(1), UiLength()));
+
+            CONTINUE_SECTION_WHEN_IDLE(window, columnView, buttons, positionsBefore)
+            {
+                // one sem is 20 DIPs in the mock UI
+                REQUIRE((*buttons)[250]->position() == positionsBefore[250] + Point(0, 20));
+
+                for (size_t i = 0; i < buttons->size(); i++) {
+                    P<MeasureCountingButton> button = (*buttons)[i];
+
+                    if (i < 250)
+                        REQUIRE(button->position() == positionsBefore[i]);
+                    else if (i > 250) {
+                        REQUIRE(button->position().x == positionsBefore[i].x);
+                        REQUIRE(Dip(button->position().y) == Dip(positionsBefore[i].y + 40));
+                    }
+
+                    if (i > 0) {
+                        P<MeasureCountingButton> prevButton = (*buttons)[i - 1];
+                        double expectedY = prevButton->position().y + prevButton->size().height;
+                        // the margin of the changed child
+                        if (i == 250 || i == 251)
+                            expectedY += 20;
+
+                        REQUIRE(Dip(button->position().y) == Dip(expectedY));
+                    }
+                }
+            };
+        }
+    };
+}
@@ -0,0 +1,168 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/Array.h>
+#include <bdn/ComputedProperty.h>
+#include <bdn/property.h>
+
+using namespace bdn;
+
+class ComputedPropertyTestOwner : public Base
+{
+  public:
+    BDN_PROPERTY(int, x, setX);
+    BDN_PROPERTY(int, y, setY);
+    BDN_PROPERTY(bool, useY, setUseY);
+};
+
+TEST_CASE("ComputedProperty")
+{
+    P<ComputedPropertyTestOwner> owner = newObj<ComputedPropertyTestOwner>();
+    owner->setX(1);
+    owner->setY(10);
+
+    int computeCount = 0;
+
+    P<ComputedProperty<int>> sum = newObj<ComputedProperty<int>>([owner, &computeCount](ComputedPropertyTracker &t) {
+        computeCount++;
+        return t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, x)) + t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, y));
+    });
+
+    SECTION("lazy")
+    {
+        REQUIRE(sum->isDirty());
+        REQUIRE(computeCount == 0);
+
+        REQUIRE(sum->get() == 11);
+        REQUIRE(computeCount == 1);
+        REQUIRE(sum->getDependencyCount() == 2);
+
+        REQUIRE(sum->get() == 11);
+        REQUIRE(computeCount == 1);
+
+        owner->setX(2);
+        owner->setX(3);
+        owner->setY(20);
+        REQUIRE(sum->isDirty());
+        REQUIRE(computeCount == 1);
+
+        REQUIRE(sum->get() == 23);
+        REQUIRE(computeCount == 2);
+    }
+
+    SECTION("notifies only when value differs")
+    {
+        Array<int> notifiedValues;
+        sum->changed().subscribe([&notifiedValues](int value) { notifiedValues.add(value); });
+
+        REQUIRE(computeCount == 1);
+        REQUIRE(notifiedValues.empty());
+
+        owner->setX(2);
+        REQUIRE(computeCount == 2);
+        REQUIRE(notifiedValues == Array<int>({12}));
+
+        // different dependency values, but the same sum
+        owner->setX(3);
+        owner->setY(9);
+        REQUIRE(computeCount == 4);
+        REQUIRE(notifiedValues == Array<int>({12, 13, 12}));
+
+        SECTION("manual invalidate does not notify")
+        {
+            sum->invalidate();
+            REQUIRE(computeCount == 5);
+            REQUIRE(notifiedValues == Array<int>({12, 13, 12}));
+        }
+    }
+
+    SECTION("no notification for unchanged value")
+    {
+        P<ComputedProperty<bool>> isPositive = newObj<ComputedProperty<bool>>(
+            [owner](ComputedPropertyTracker &t) { return t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, x)) > 0; });
+
+        int notifyCount = 0;
+        isPositive->changed().subscribeParamless([&notifyCount]() { notifyCount++; });
+
+        owner->setX(5);
+        owner->setX(7);
+        REQUIRE(notifyCount == 0);
+
+        owner->setX(-1);
+        REQUIRE(notifyCount == 1);
+        REQUIRE(isPositive->get() == false);
+    }
+
+    SECTION("glitch free diamond")
+    {
+        int doubledComputeCount = 0;
+        P<ComputedProperty<int>> doubled =
+            newObj<ComputedProperty<int>>([owner, &doubledComputeCount](ComputedPropertyTracker &t) {
+                doubledComputeCount++;
+                return t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, x)) * 2;
+            });
+
+        int combinedComputeCount = 0;
+        P<ComputedProperty<int>> combined =
+            newObj<ComputedProperty<int>>([sum, doubled, &combinedComputeCount](ComputedPropertyTracker &t) {
+                combinedComputeCount++;
+                return t.read(*sum) - t.read(*doubled);
+            });
+
+        // combined = (x + y) - 2x = y - x
+        Array<int> notifiedValues;
+        combined->changed().subscribe([&notifiedValues](int value) { notifiedValues.add(value); });
+
+        REQUIRE(combinedComputeCount == 1);
+        REQUIRE(combined->get() == 9);
+
+        owner->setX(4);
+
+        // combined must only have been computed once, with both inputs
+        // already updated. An intermediate value (like 14 - 2 = 12) must
+        // never be reported.
+        REQUIRE(combinedComputeCount == 2);
+        REQUIRE(doubledComputeCount == 2);
+        REQUIRE(computeCount == 2);
+        REQUIRE(notifiedValues == Array<int>({6}));
+    }
+
+    SECTION("dynamic dependencies")
+    {
+        P<ComputedProperty<int>> selected = newObj<ComputedProperty<int>>([owner](ComputedPropertyTracker &t) {
+            if (t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, useY)))
+                return t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, y));
+            else
+                return t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, x));
+        });
+
+        REQUIRE(selected->get() == 1);
+        REQUIRE(selected->getDependencyCount() == 2);
+
+        owner->setY(11);
+        REQUIRE(!selected->isDirty());
+
+        owner->setUseY(true);
+        REQUIRE(selected->get() == 11);
+        REQUIRE(selected->getDependencyCount() == 2);
+
+        // x is no longer a dependency
+        owner->setX(100);
+        REQUIRE(!selected->isDirty());
+
+        owner->setY(12);
+        REQUIRE(selected->isDirty());
+        REQUIRE(selected->get() == 12);
+    }
+
+    SECTION("destroyed property unsubscribes")
+    {
+        REQUIRE(sum->get() == 11);
+
+        sum = nullptr;
+
+        // must not crash
+        owner->setX(2);
+        owner->setY(3);
+    }
+}
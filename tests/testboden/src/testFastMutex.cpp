@@ -0,0 +1,136 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/Thread.h>
+#include <bdn/FastMutex.h>
+#include <bdn/SpinLock.h>
+#include <bdn/StopWatch.h>
+#include <bdn/Array.h>
+
+#include <atomic>
+
+using namespace bdn;
+
+template <class MutexType> void testNonRecursiveMutex()
+{
+    MutexType mutex;
+
+    SECTION("lockUnlock")
+    {
+        mutex.lock();
+        mutex.unlock();
+
+        mutex.lock();
+        mutex.unlock();
+    }
+
+    SECTION("tryLock")
+    {
+        REQUIRE(mutex.tryLock());
+
+        // non-recursive. So a second tryLock must fail
+        REQUIRE(!mutex.tryLock());
+
+        mutex.unlock();
+
+        REQUIRE(mutex.tryLock());
+        mutex.unlock();
+    }
+
+#if BDN_HAVE_THREADS
+
+    SECTION("blocksOtherThread")
+    {
+        std::atomic<bool> threadLocked(false);
+
+        {
+            typename MutexType::Lock lock(mutex);
+
+            Thread::exec([&threadLocked, &mutex]() {
+                mutex.lock();
+                threadLocked = true;
+                mutex.unlock();
+            });
+
+            Thread::sleepMillis(1000);
+
+            REQUIRE(!threadLocked);
+        }
+
+        Thread::sleepMillis(1000);
+
+        REQUIRE(threadLocked);
+
+        StopWatch watch;
+
+        mutex.lock();
+
+        REQUIRE(watch.getMillis() < 1000);
+        mutex.unlock();
+    }
+
+    SECTION("Unlock")
+    {
+        std::atomic<bool> threadLocked(false);
+
+        typename MutexType::Lock lock(mutex);
+
+        Thread::exec([&threadLocked, &mutex]() {
+            mutex.lock();
+            threadLocked = true;
+            mutex.unlock();
+        });
+
+        Thread::sleepMillis(1000);
+
+        REQUIRE(!threadLocked);
+
+        {
+            typename MutexType::Unlock unlock(mutex);
+
+            Thread::sleepMillis(1000);
+
+            REQUIRE(threadLocked);
+        }
+
+        // must be locked again
+        REQUIRE(!mutex.tryLock());
+    }
+
+    SECTION("contention")
+    {
+        // several threads increment a non-atomic counter. If the mutex does
+        // not provide mutual exclusion then increments are lost.
+        const int threadCount = 4;
+        const int incrementsPerThread = 100000;
+
+        int64_t counter = 0;
+
+        Array<std::future<void>> futures;
+        for (int i = 0; i < threadCount; i++) {
+            futures.add(Thread::exec([&mutex, &counter]() {
+                for (int i = 0; i < incrementsPerThread; i++) {
+                    typename MutexType::Lock lock(mutex);
+                    counter++;
+                }
+            }));
+        }
+
+        for (auto &future : futures)
+            future.get();
+
+        REQUIRE(counter == threadCount * incrementsPerThread);
+    }
+
+#endif
+}
+
+TEST_CASE("FastMutex")
+{
+    testNonRecursiveMutex<FastMutex>();
+}
+
+TEST_CASE("SpinLock")
+{
+    testNonRecursiveMutex<SpinLock>();
+}
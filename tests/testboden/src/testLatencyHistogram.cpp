@@ -0,0 +1,121 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/LatencyHistogram.h>
+#include <bdn/Thread.h>
+#include <bdn/Array.h>
+
+using namespace bdn;
+
+TEST_CASE("LatencyHistogram")
+{
+    LatencyHistogram histogram;
+
+    SECTION("empty")
+    {
+        LatencyHistogram::Snapshot snapshot = histogram.getSnapshot();
+
+        REQUIRE(snapshot.count == 0);
+        REQUIRE(snapshot.maxNanos == 0);
+        REQUIRE(snapshot.getMeanNanos() == 0);
+        REQUIRE(snapshot.getPercentileNanos(50) == 0);
+        REQUIRE(snapshot.bucketCounts.size() == LatencyHistogram::bucketCount);
+    }
+
+    SECTION("bucketBounds")
+    {
+        // every value must be in a bucket whose upper bound is >= the value
+        // and whose predecessor's upper bound is < the value.
+        for (int64_t value = 0; value < 100000; value++) {
+            int bucketIndex = LatencyHistogram::getBucketIndex(value);
+
+            REQUIRE(LatencyHistogram::getBucketUpperBound(bucketIndex) >= value);
+            if (bucketIndex > 0)
+                REQUIRE(LatencyHistogram::getBucketUpperBound(bucketIndex - 1) < value);
+        }
+
+        // the relative error is bounded
+        for (int64_t value = 1000; value < ((int64_t)1) << 38; value = value * 3 + 1) {
+            int64_t upperBound = LatencyHistogram::getBucketUpperBound(LatencyHistogram::getBucketIndex(value));
+
+            REQUIRE(upperBound >= value);
+            REQUIRE(upperBound - value <= value / LatencyHistogram::subBucketCount);
+        }
+
+        // values that exceed the range go to the last bucket
+        REQUIRE(LatencyHistogram::getBucketIndex(INT64_MAX) == LatencyHistogram::bucketCount - 1);
+    }
+
+    SECTION("record")
+    {
+        for (int i = 1; i <= 100; i++)
+            histogram.record(i * 1000);
+
+        LatencyHistogram::Snapshot snapshot = histogram.getSnapshot();
+
+        REQUIRE(snapshot.count == 100);
+        REQUIRE(snapshot.maxNanos == 100000);
+        REQUIRE(snapshot.getMeanNanos() == 50500);
+
+        int64_t median = snapshot.getPercentileNanos(50);
+        REQUIRE(median >= 50000);
+        REQUIRE(median <= 50000 + 50000 / LatencyHistogram::subBucketCount);
+
+        REQUIRE(snapshot.getPercentileNanos(100) == 100000);
+        REQUIRE(snapshot.getPercentileNanos(0) >= 1000);
+        REQUIRE(snapshot.getPercentileNanos(0) <= 1000 + 1000 / LatencyHistogram::subBucketCount);
+
+        histogram.reset();
+
+        snapshot = histogram.getSnapshot();
+        REQUIRE(snapshot.count == 0);
+        REQUIRE(snapshot.getPercentileNanos(50) == 0);
+    }
+
+    SECTION("negative")
+    {
+        histogram.record(-5);
+
+        LatencyHistogram::Snapshot snapshot = histogram.getSnapshot();
+        REQUIRE(snapshot.count == 1);
+        REQUIRE(snapshot.bucketCounts[0] == 1);
+    }
+
+    SECTION("toString")
+    {
+        histogram.record(1500);
+
+        String text = histogram.getSnapshot().toString();
+        REQUIRE(text.contains("count=1"));
+        REQUIRE(text.contains("max=1.5us"));
+    }
+
+#if BDN_HAVE_THREADS
+    SECTION("concurrentRecording")
+    {
+        const int threadCount = 4;
+        const int valuesPerThread = 100000;
+
+        Array<std::future<void>> futures;
+        for (int threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+            futures.add(Thread::exec([&histogram, threadIndex]() {
+                for (int i = 0; i < valuesPerThread; i++)
+                    histogram.record(threadIndex * 1000 + (i % 100));
+            }));
+        }
+
+        for (auto &future : futures)
+            future.get();
+
+        LatencyHistogram::Snapshot snapshot = histogram.getSnapshot();
+
+        REQUIRE(snapshot.count == threadCount * valuesPerThread);
+        REQUIRE(snapshot.maxNanos == (threadCount - 1) * 1000 + 99);
+
+        int64_t bucketTotal = 0;
+        for (int64_t bucketCount : snapshot.bucketCounts)
+            bucketTotal += bucketCount;
+        REQUIRE(bucketTotal == threadCount * valuesPerThread);
+    }
+#endif
+}
@@ -24,6 +24,14 @@ class LayoutCoordinatorForTesting : public LayoutCoordinator
     }
 };
 
+class LayoutCoordinatorTestState : public Base
+{
+  public:
+    Array<String> layoutOrder;
+    bool eventHandled = false;
+    int overrideCallCount = 0;
+};
+
 TEST_CASE("LayoutCoordinator")
 {
     P<LayoutCoordinatorForTesting> coord = newObj<LayoutCoordinatorForTesting>();
@@ -137,25 +145,11 @@ TEST_CASE("LayoutCoordinator")
     }
 }
 
-SECTION("Pending events are handled between layouts")
+SECTION("Pending layouts are done in a single parent-first pass")
 {
-    // Layout operations are handled by the coordinator in "parent first" order.
-    // Parents are layouted before their children, since the children's size
-    // might change during the parent layout. BUT that introduces a special
-    // case: when the size of a child view changes then the child view will
-    // usually automatically schedule a layout in the corresponding property
-    // change handler. That is also the correct behaviour. But the property
-    // change handler call is posted to the event queue, so it does not happen
-    // immediately during the parent layout. If the child was now already
-    // scheduled for layout, then it is important that the pending change events
-    // are executed before the child's layout is started. Otherwise the
-    // duplicate layout will not be detected and the child is layouted twice. We
-    // test here that queued up events are executed between layout operations.
-    // That ensures that no such duplicate layouts will happen.
-
-    // note that for this test we need the two layout calls to happen in a
-    // defined order. The order is only defined if one is on a deeper level, so
-    // we create a child view inside the (unused) view3.
+    // note that for this test we need the layout calls to happen in a defined
+    // order. The order is only defined if one is on a deeper level, so we
+    // create a child view inside the (unused) view3.
 
     P<Button> view4 = newObj<Button>();
 
@@ -168,46 +162,74 @@ SECTION("Pending events are handled between layouts")
         int initialLayoutCount1 = cast<bdn::test::MockViewCore>(view1->getViewCore())->getLayoutCount();
         int initialLayoutCount4 = cast<bdn::test::MockViewCore>(view4->getViewCore())->getLayoutCount();
 
-        view1->needLayout(View::InvalidateReason::customDataChanged);
-        view4->needLayout(View::InvalidateReason::customDataChanged);
+        P<LayoutCoordinatorTestState> state = newObj<LayoutCoordinatorTestState>();
 
-        // layout order is parent-first, so view1 will always be layouted before
-        // view4
+        // register the child first. The parent must still be layouted first.
+        coord->viewNeedsLayout(view4);
+        coord->viewNeedsLayout(view1);
 
-        cast<bdn::test::MockViewCore>(view1->getViewCore())
-            ->setOverrideLayoutFunc([view1, view2, view3, view4, coord, initialLayoutCount1, initialLayoutCount4]() {
-                // view 4 should not have been layouted yet
-                REQUIRE(cast<bdn::test::MockViewCore>(view4->getViewCore())->getLayoutCount() == initialLayoutCount4);
+        cast<bdn::test::MockViewCore>(view1->getViewCore())->setOverrideLayoutFunc([view4, coord, state]() {
+            state->layoutOrder.add("view1");
 
-                // and view 1 only once (the current call)
-                REQUIRE(cast<bdn::test::MockViewCore>(view1->getViewCore())->getLayoutCount() ==
-                        initialLayoutCount1 + 1);
+            // schedule something to the event queue. The remaining layouts
+            // must be done in the same pass, before this is handled.
+            asyncCallFromMainThread([state]() { state->eventHandled = true; });
 
-                // now schedule something to the event queue.
-                // This simulates the property change notification.
-                asyncCallFromMainThread(
-                    [view1, view2, view3, view4, coord, initialLayoutCount1, initialLayoutCount4]() {
-                        // view4 should still not have been layouted yet
-                        REQUIRE(cast<bdn::test::MockViewCore>(view4->getViewCore())->getLayoutCount() ==
-                                initialLayoutCount4);
+            // view4 is already pending. The duplicate request must be
+            // detected.
+            coord->viewNeedsLayout(view4);
 
-                        // and view1 still only once
-                        REQUIRE(cast<bdn::test::MockViewCore>(view1->getViewCore())->getLayoutCount() ==
-                                initialLayoutCount1 + 1);
-                    });
+            return false;
+        });
 
-                // execute the normal layout implementation
-                return false;
-            });
+        cast<bdn::test::MockViewCore>(view4->getViewCore())->setOverrideLayoutFunc([state]() {
+            state->layoutOrder.add("view4");
 
-        CONTINUE_SECTION_WHEN_IDLE(view1, view2, view3, view4, initialLayoutCount1, initialLayoutCount4, coord)
+            REQUIRE(!state->eventHandled);
+
+            return false;
+        });
+
+        // view3 must be kept alive. Otherwise view4 loses its core.
+        CONTINUE_SECTION_WHEN_IDLE(view1, view3, view4, initialLayoutCount1, initialLayoutCount4, state)
         {
-            // verify that now all layout requests have been handled.
+            REQUIRE(state->eventHandled);
+
+            REQUIRE(state->layoutOrder == Array<String>({"view1", "view4"}));
+
             REQUIRE(cast<bdn::test::MockViewCore>(view1->getViewCore())->getLayoutCount() == initialLayoutCount1 + 1);
             REQUIRE(cast<bdn::test::MockViewCore>(view4->getViewCore())->getLayoutCount() == initialLayoutCount4 + 1);
         };
     };
 }
+
+SECTION("Layout request for already layouted view is done in next pass")
+{
+    P<bdn::test::MockViewCore> core1 = cast<bdn::test::MockViewCore>(view1->getViewCore());
+
+    int initialLayoutCount1 = core1->getLayoutCount();
+
+    P<LayoutCoordinatorTestState> state = newObj<LayoutCoordinatorTestState>();
+
+    // view1 requests a new layout from its layout function (once). That must
+    // not cause an endless loop or a recursive layout call.
+    core1->setOverrideLayoutFunc([view1, coord, state]() {
+        state->overrideCallCount++;
+
+        if (state->overrideCallCount == 1)
+            coord->viewNeedsLayout(view1);
+
+        return false;
+    });
+
+    coord->viewNeedsLayout(view1);
+
+    CONTINUE_SECTION_WHEN_IDLE(core1, initialLayoutCount1, state)
+    {
+        REQUIRE(state->overrideCallCount == 2);
+        REQUIRE(core1->getLayoutCount() == initialLayoutCount1 + 2);
+    };
+}
 }
 ;
 }
@@ -0,0 +1,202 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/ObservableArray.h>
+
+using namespace bdn;
+
+static ArrayChange makeArrayChange(ArrayChange::Type type, size_t index, size_t count, size_t toIndex = 0)
+{
+    return ArrayChange{type, index, count, toIndex};
+}
+
+TEST_CASE("ObservableArray")
+{
+    using Type = ArrayChange::Type;
+
+    P<ObservableArray<int>> arr = newObj<ObservableArray<int>>();
+
+    Array<Array<ArrayChange>> notifications;
+    arr->onChange().subscribe([&notifications](const Array<ArrayChange> &changes) { notifications.add(changes); });
+
+    SECTION("without batch")
+    {
+        arr->add(1);
+        arr->add(2);
+        arr->insertAt(0, 0);
+
+        REQUIRE(arr->getArray() == Array<int>({0, 1, 2}));
+        REQUIRE(notifications.size() == 3);
+        REQUIRE(notifications[0] == Array<ArrayChange>({makeArrayChange(Type::insert, 0, 1)}));
+        REQUIRE(notifications[1] == Array<ArrayChange>({makeArrayChange(Type::insert, 1, 1)}));
+        REQUIRE(notifications[2] == Array<ArrayChange>({makeArrayChange(Type::insert, 0, 1)}));
+
+        SECTION("set")
+        {
+            arr->set(1, 10);
+            REQUIRE(notifications.back() == Array<ArrayChange>({makeArrayChange(Type::update, 1, 1)}));
+
+            // same value does not notify
+            arr->set(1, 10);
+            REQUIRE(notifications.size() == 4);
+        }
+
+        SECTION("move")
+        {
+            arr->move(0, 2);
+            REQUIRE(arr->getArray() == Array<int>({1, 2, 0}));
+            REQUIRE(notifications.back() == Array<ArrayChange>({makeArrayChange(Type::move, 0, 1, 2)}));
+
+            arr->move(2, 0);
+            REQUIRE(arr->getArray() == Array<int>({0, 1, 2}));
+            REQUIRE(notifications.back() == Array<ArrayChange>({makeArrayChange(Type::move, 2, 1, 0)}));
+        }
+
+        SECTION("remove")
+        {
+            arr->removeRange(1, 2);
+            REQUIRE(arr->getArray() == Array<int>({0}));
+            REQUIRE(notifications.back() == Array<ArrayChange>({makeArrayChange(Type::remove, 1, 2)}));
+
+            arr->clear();
+            REQUIRE(arr->isEmpty());
+            REQUIRE(notifications.back() == Array<ArrayChange>({makeArrayChange(Type::remove, 0, 1)}));
+
+            // clearing an empty array does not notify
+            arr->clear();
+            REQUIRE(notifications.size() == 5);
+        }
+
+        SECTION("index out of range")
+        {
+            REQUIRE_THROWS_PROGRAMMING_ERROR(arr->insertAt(4, 1));
+            REQUIRE_THROWS_PROGRAMMING_ERROR(arr->removeRange(2, 2));
+            REQUIRE_THROWS_PROGRAMMING_ERROR(arr->set(3, 1));
+            REQUIRE_THROWS_PROGRAMMING_ERROR(arr->move(0, 3));
+            REQUIRE(notifications.size() == 3);
+        }
+    }
+
+    SECTION("batch")
+    {
+        for (int i = 0; i < 10; i++)
+            arr->add(i);
+        notifications.clear();
+
+        SECTION("appends are merged")
+        {
+            {
+                PropertyBatch batch;
+
+                for (int i = 0; i < 100; i++)
+                    arr->add(100 + i);
+
+                REQUIRE(notifications.empty());
+            }
+
+            REQUIRE(notifications.size() == 1);
+            REQUIRE(notifications[0] == Array<ArrayChange>({makeArrayChange(Type::insert, 10, 100)}));
+            REQUIRE(arr->getSize() == 110);
+        }
+
+        SECTION("removals are merged")
+        {
+            {
+                PropertyBatch batch;
+
+                // forward
+                arr->removeAt(2);
+                arr->removeAt(2);
+
+                // backward
+                arr->removeAt(1);
+                arr->removeAt(0);
+            }
+
+            REQUIRE(notifications.size() == 1);
+            REQUIRE(notifications[0] == Array<ArrayChange>({makeArrayChange(Type::remove, 0, 4)}));
+            REQUIRE(arr->getArray() == Array<int>({4, 5, 6, 7, 8, 9}));
+        }
+
+        SECTION("updates are merged")
+        {
+            {
+                PropertyBatch batch;
+
+                arr->set(3, 30);
+                arr->set(4, 40);
+                arr->set(2, 20);
+                arr->set(3, 31);
+            }
+
+            REQUIRE(notifications.size() == 1);
+            REQUIRE(notifications[0] == Array<ArrayChange>({makeArrayChange(Type::update, 2, 3)}));
+        }
+
+        SECTION("update of inserted element")
+        {
+            {
+                PropertyBatch batch;
+
+                arr->add(10);
+                arr->add(11);
+                arr->set(10, 100);
+            }
+
+            REQUIRE(notifications.size() == 1);
+            REQUIRE(notifications[0] == Array<ArrayChange>({makeArrayChange(Type::insert, 10, 2)}));
+            REQUIRE(arr->getArray()[10] == 100);
+        }
+
+        SECTION("different kinds are kept in order")
+        {
+            {
+                PropertyBatch batch;
+
+                arr->add(10);
+                arr->removeAt(0);
+                arr->move(0, 5);
+                arr->set(9, 90);
+
+                REQUIRE(arr->getPendingChanges().size() == 4);
+            }
+
+            REQUIRE(notifications.size() == 1);
+            REQUIRE(notifications[0] == Array<ArrayChange>({makeArrayChange(Type::insert, 10, 1),
+                                                            makeArrayChange(Type::remove, 0, 1),
+                                                            makeArrayChange(Type::move, 0, 1, 5),
+                                                            makeArrayChange(Type::update, 9, 1)}));
+
+            // replaying the changes on a copy of the old state must give the
+            // new state.
+            Array<int> replayed({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+            for (auto &change : notifications[0]) {
+                switch (change.type) {
+                case Type::insert:
+                    // the records do not contain values. Inserted elements
+                    // get their value from the final array below.
+                    replayed.insert(replayed.begin() + change.index, change.count, -1);
+                    break;
+                case Type::remove:
+                    replayed.erase(replayed.begin() + change.index, replayed.begin() + change.index + change.count);
+                    break;
+                case Type::move: {
+                    int el = replayed[change.index];
+                    replayed.erase(replayed.begin() + change.index);
+                    replayed.insert(replayed.begin() + change.toIndex, el);
+                    break;
+                }
+                case Type::update:
+                    break;
+                }
+            }
+            for (size_t i = 0; i < replayed.size() && i < arr->getSize(); i++) {
+                if (replayed[i] == -1)
+                    replayed[i] = (*arr)[i];
+            }
+            replayed[9] = 90;
+
+            REQUIRE(replayed == arr->getArray());
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/ObservableMap.h>
+
+using namespace bdn;
+
+TEST_CASE("ObservableMap")
+{
+    using Change = MapChange<String>;
+    using Type = Change::Type;
+
+    P<ObservableMap<String, int>> map = newObj<ObservableMap<String, int>>();
+
+    Array<Array<Change>> notifications;
+    map->onChange().subscribe([&notifications](const Array<Change> &changes) { notifications.add(changes); });
+
+    SECTION("without batch")
+    {
+        map->set("a", 1);
+        map->set("b", 2);
+        map->set("a", 3);
+        map->set("a", 3);
+        map->remove("b");
+        map->remove("x");
+
+        REQUIRE(map->getSize() == 1);
+        REQUIRE(*map->find("a") == 3);
+        REQUIRE(map->find("b") == nullptr);
+
+        REQUIRE(notifications.size() == 4);
+        REQUIRE(notifications[0] == Array<Change>({Change{Type::insert, "a"}}));
+        REQUIRE(notifications[1] == Array<Change>({Change{Type::insert, "b"}}));
+        REQUIRE(notifications[2] == Array<Change>({Change{Type::update, "a"}}));
+        REQUIRE(notifications[3] == Array<Change>({Change{Type::remove, "b"}}));
+    }
+
+    SECTION("batch")
+    {
+        map->set("existing1", 1);
+        map->set("existing2", 2);
+        map->set("existing3", 3);
+        notifications.clear();
+
+        {
+            PropertyBatch batch;
+
+            map->set("new1", 1);
+            map->set("new1", 10);
+
+            map->set("new2", 2);
+            map->remove("new2");
+
+            map->set("existing1", 100);
+            map->set("existing1", 101);
+
+            map->remove("existing2");
+
+            map->remove("existing3");
+            map->set("existing3", 3);
+
+            REQUIRE(notifications.empty());
+            REQUIRE(map->getPendingChangeCount() == 5);
+        }
+
+        REQUIRE(notifications.size() == 1);
+        REQUIRE(notifications[0] == Array<Change>({Change{Type::insert, "new1"}, Change{Type::update, "existing1"},
+                                                   Change{Type::remove, "existing2"},
+                                                   Change{Type::update, "existing3"}}));
+    }
+
+    SECTION("clear")
+    {
+        map->set("a", 1);
+        map->set("b", 2);
+        notifications.clear();
+
+        {
+            PropertyBatch batch;
+            map->clear();
+        }
+
+        REQUIRE(map->isEmpty());
+        REQUIRE(notifications.size() == 1);
+        REQUIRE(notifications[0] == Array<Change>({Change{Type::remove, "a"}, Change{Type::remove, "b"}}));
+    }
+}
@@ -3,6 +3,8 @@
 
 #include <bdn/OneShotStateNotifier.h>
 #include <bdn/Signal.h>
+#include <bdn/Thread.h>
+#include <bdn/test/FakeTimeDispatcher.h>
 
 using namespace bdn;
 
@@ -201,4 +203,105 @@ TEST_CASE("OneShotStateNotifier")
             CONTINUE_SECTION_WHEN_IDLE(testData, notifier) { REQUIRE(testData->callCount1 == 1); };
         }
     }
+
+    SECTION("late subscribers called inline")
+    {
+        using Notifier = OneShotStateNotifier<int, String>;
+        P<Notifier> notifier = newObj<Notifier>(Notifier::LateSubscriberCall::callInline);
+
+        *notifier += [testData](int a, String b) {
+            REQUIRE(a == 42);
+            REQUIRE(b == "hello");
+            testData->callCount1++;
+        };
+
+        notifier->postNotification(42, "hello");
+
+        SECTION("subscribed before initial notification is done")
+        {
+            // the initial notification is still pending. The new subscriber
+            // is called with it.
+            *notifier += [testData](int a, String b) { testData->callCount1++; };
+
+            REQUIRE(testData->callCount1 == 0);
+
+            CONTINUE_SECTION_WHEN_IDLE(notifier, testData) { REQUIRE(testData->callCount1 == 2); };
+        }
+
+        SECTION("subscribed after initial notification is done")
+        {
+            CONTINUE_SECTION_WHEN_IDLE(notifier, testData)
+            {
+                REQUIRE(testData->callCount1 == 1);
+
+                Thread::Id subscriberThreadId;
+
+                P<INotifierSubscription> sub = notifier->subscribe([testData, &subscriberThreadId](int a, String b) {
+                    REQUIRE(a == 42);
+                    REQUIRE(b == "hello");
+                    subscriberThreadId = Thread::getCurrentId();
+                    testData->callCount1++;
+                });
+
+                // called immediately, before subscribe returned
+                REQUIRE(testData->callCount1 == 2);
+                REQUIRE(subscriberThreadId == Thread::getCurrentId());
+
+                // unsubscribing has no effect
+                notifier->unsubscribe(sub);
+
+                // background threads are not bounced to the main thread
+                Thread::Id backgroundThreadId;
+
+                Thread::exec([notifier, testData, &backgroundThreadId, &subscriberThreadId]() {
+                    backgroundThreadId = Thread::getCurrentId();
+
+                    *notifier += [testData, &subscriberThreadId](int, String) {
+                        subscriberThreadId = Thread::getCurrentId();
+                        testData->callCount1++;
+                    };
+                }).get();
+
+                REQUIRE(testData->callCount1 == 3);
+                REQUIRE(subscriberThreadId == backgroundThreadId);
+            };
+        }
+    }
+
+    SECTION("late subscribers posted to dispatcher")
+    {
+        P<bdn::test::FakeTimeDispatcher> dispatcher = newObj<bdn::test::FakeTimeDispatcher>();
+
+        using Notifier = OneShotStateNotifier<int>;
+        P<Notifier> notifier = newObj<Notifier>(Notifier::LateSubscriberCall::postToDispatcher, dispatcher);
+
+        *notifier += [testData](int a) {
+            REQUIRE(a == 42);
+            testData->callCount1++;
+        };
+
+        notifier->postNotification(42);
+
+        REQUIRE(testData->callCount1 == 0);
+        REQUIRE(dispatcher->executeReady() == 1);
+        REQUIRE(testData->callCount1 == 1);
+
+        *notifier += [testData](int a) {
+            REQUIRE(a == 42);
+            testData->callCount1++;
+        };
+
+        REQUIRE(testData->callCount1 == 1);
+        REQUIRE(dispatcher->executeReady() == 1);
+        REQUIRE(testData->callCount1 == 2);
+    }
+
+    SECTION("dispatcher must match mode")
+    {
+        using Notifier = OneShotStateNotifier<int>;
+        P<bdn::test::FakeTimeDispatcher> dispatcher = newObj<bdn::test::FakeTimeDispatcher>();
+
+        REQUIRE_THROWS_PROGRAMMING_ERROR(newObj<Notifier>(Notifier::LateSubscriberCall::postToDispatcher));
+        REQUIRE_THROWS_PROGRAMMING_ERROR(newObj<Notifier>(Notifier::LateSubscriberCall::callInline, dispatcher));
+    }
 }
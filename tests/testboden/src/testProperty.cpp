@@ -4,6 +4,7 @@
 #include <bdn/property.h>
 #include <bdn/Array.h>
 #include <bdn/View.h>
+#include <bdn/Button.h>
 
 using namespace bdn;
 
@@ -960,6 +961,67 @@ template <class VALUE_TYPE> static void testViewProperty(const VALUE_TYPE &initi
     }
 }
 
+/** A value type that counts how often it is copied.*/
+class CopyCountingValue
+{
+  public:
+    CopyCountingValue(int value = 0) : value(value) {}
+
+    CopyCountingValue(const CopyCountingValue &o) : value(o.value) { copyCount++; }
+    CopyCountingValue(CopyCountingValue &&o) : value(o.value) {}
+
+    CopyCountingValue &operator=(const CopyCountingValue &o)
+    {
+        value = o.value;
+        copyCount++;
+        return *this;
+    }
+
+    CopyCountingValue &operator=(CopyCountingValue &&o)
+    {
+        value = o.value;
+        return *this;
+    }
+
+    bool operator==(const CopyCountingValue &o) const { return value == o.value; }
+    bool operator!=(const CopyCountingValue &o) const { return value != o.value; }
+
+    int value;
+
+    static int copyCount;
+};
+
+int CopyCountingValue::copyCount = 0;
+
+class TestRefPropertyOwner : public Base
+{
+  public:
+    BDN_REF_PROPERTY(CopyCountingValue, myProp, setMyProp);
+    BDN_REF_PROPERTY(String, stringProp, setStringProp);
+};
+
+class TestPropOwnerWithCustomNotifier : public Base
+{
+  public:
+    int myProp() const { return _val; }
+
+    void setMyProp(int val)
+    {
+        if (_val != val) {
+            _val = val;
+            BDN_NOTIFY_PROPERTY_CHANGED(*this, myProp);
+        }
+    }
+
+    IPropertyNotifier<int> &myPropChanged() const { return *_notifier; }
+
+    BDN_FINALIZE_CUSTOM_PROPERTY(int, myProp, setMyProp);
+
+  private:
+    int _val = 0;
+    P<PropertyNotifier<int>> _notifier = newObj<PropertyNotifier<int>>();
+};
+
 TEST_CASE("properties")
 {
     SECTION("BDN_PROPERTY")
@@ -1046,4 +1108,144 @@ TEST_CASE("properties")
         SECTION("String")
         testViewProperty<String>("", "hello");
     }
+
+    SECTION("notifier table")
+    {
+        P<TestPropertyOwner<int>> owner = newObj<TestPropertyOwner<int>>();
+
+        // setting the value when nobody has requested the notifier must not
+        // allocate anything.
+        owner->setMyProp(42);
+        REQUIRE(owner->_getPropertyNotifierTable(false) == nullptr);
+
+        int callCount = 0;
+        owner->myPropChanged() += [&callCount](const int &) { callCount++; };
+
+        PropertyNotifierTable *table = owner->_getPropertyNotifierTable(false);
+        REQUIRE(table != nullptr);
+        REQUIRE(table->size() == 1);
+
+        // requesting the notifier again must return the same object
+        REQUIRE(&owner->myPropChanged() == &owner->myPropChanged());
+        REQUIRE(table->size() == 1);
+
+        owner->setMyProp(43);
+        REQUIRE(callCount == 1);
+
+        SECTION("multiple properties")
+        {
+            P<TestPropertyOtherOwner<String>> otherOwner = newObj<TestPropertyOtherOwner<String>>();
+            otherOwner->setOtherProp("hello");
+            REQUIRE(otherOwner->_getPropertyNotifierTable(false) == nullptr);
+
+            P<Button> button = newObj<Button>();
+            button->setLabel("hello");
+            button->setVisible(false);
+            REQUIRE(button->_getPropertyNotifierTable(false) == nullptr);
+
+            int labelCallCount = 0;
+            int visibleCallCount = 0;
+            button->labelChanged() += [&labelCallCount](const String &) { labelCallCount++; };
+            button->visibleChanged() += [&visibleCallCount](const bool &) { visibleCallCount++; };
+            REQUIRE(button->_getPropertyNotifierTable(false)->size() == 2);
+
+            button->setLabel("world");
+            REQUIRE(labelCallCount == 1);
+            REQUIRE(visibleCallCount == 0);
+
+            button->setVisible(true);
+            REQUIRE(labelCallCount == 1);
+            REQUIRE(visibleCallCount == 1);
+        }
+    }
+
+    SECTION("BDN_REF_PROPERTY")
+    {
+        P<TestRefPropertyOwner> owner = newObj<TestRefPropertyOwner>();
+
+        TestRefPropertyOwner *ownerPtr = owner;
+
+        Array<int> notifiedValues;
+        for (int i = 0; i < 3; i++) {
+            owner->myPropChanged() += [&notifiedValues, ownerPtr](const CopyCountingValue &value) {
+                // the subscriber gets a reference to the stored value
+                REQUIRE(&value == &ownerPtr->myProp());
+                notifiedValues.add(value.value);
+            };
+        }
+
+        CopyCountingValue::copyCount = 0;
+
+        SECTION("set temporary")
+        {
+            owner->setMyProp(CopyCountingValue(42));
+
+            REQUIRE(owner->myProp().value == 42);
+            REQUIRE(notifiedValues == Array<int>({42, 42, 42}));
+            REQUIRE(CopyCountingValue::copyCount == 0);
+        }
+
+        SECTION("set moved value")
+        {
+            CopyCountingValue value(42);
+            owner->setMyProp(std::move(value));
+
+            REQUIRE(owner->myProp().value == 42);
+            REQUIRE(CopyCountingValue::copyCount == 0);
+        }
+
+        SECTION("set lvalue")
+        {
+            CopyCountingValue value(42);
+            owner->setMyProp(value);
+
+            REQUIRE(owner->myProp().value == 42);
+            REQUIRE(notifiedValues == Array<int>({42, 42, 42}));
+
+            // one copy for the setter parameter
+            REQUIRE(CopyCountingValue::copyCount == 1);
+        }
+
+        SECTION("same value")
+        {
+            owner->setMyProp(CopyCountingValue(0));
+
+            REQUIRE(notifiedValues.isEmpty());
+        }
+
+        SECTION("get")
+        {
+            const CopyCountingValue &value = owner->myProp();
+            REQUIRE(value.value == 0);
+            REQUIRE(&value == &owner->myProp());
+            REQUIRE(CopyCountingValue::copyCount == 0);
+        }
+
+        SECTION("binding")
+        {
+            P<TestPropertyOtherOwner<String>> otherOwner = newObj<TestPropertyOtherOwner<String>>();
+
+            BDN_BIND_TO_PROPERTY(*owner, setStringProp, *otherOwner, otherProp);
+            otherOwner->setOtherProp("hello");
+            REQUIRE(owner->stringProp() == "hello");
+
+            BDN_BIND_TO_PROPERTY(*otherOwner, setOtherProp, *owner, stringProp);
+            owner->setStringProp("world");
+            REQUIRE(otherOwner->otherProp() == "world");
+        }
+    }
+
+    SECTION("custom notifier")
+    {
+        P<TestPropOwnerWithCustomNotifier> owner = newObj<TestPropOwnerWithCustomNotifier>();
+
+        int callCount = 0;
+        owner->myPropChanged() += [&callCount](const int &) { callCount++; };
+
+        owner->setMyProp(17);
+
+        // the notification must go through the custom notifier
+        REQUIRE(callCount == 1);
+        REQUIRE(owner->_getPropertyNotifierTable(false) == nullptr);
+    }
 }
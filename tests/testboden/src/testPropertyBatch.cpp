@@ -0,0 +1,195 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/PropertyBatch.h>
+#include <bdn/ComputedProperty.h>
+#include <bdn/property.h>
+#include <bdn/Array.h>
+#include <bdn/Button.h>
+#include <bdn/Window.h>
+#include <bdn/test/MockUiProvider.h>
+#include <bdn/test/MockViewCore.h>
+
+using namespace bdn;
+
+class PropertyBatchTestOwner : public Base
+{
+  public:
+    BDN_PROPERTY(int, a, setA);
+    BDN_PROPERTY(int, b, setB);
+};
+
+TEST_CASE("PropertyBatch")
+{
+    P<PropertyBatchTestOwner> owner = newObj<PropertyBatchTestOwner>();
+
+    Array<String> notifications;
+    owner->aChanged().subscribe([&notifications](int value) { notifications.add("a=" + std::to_string(value)); });
+    owner->bChanged().subscribe([&notifications](int value) { notifications.add("b=" + std::to_string(value)); });
+
+    SECTION("no batch")
+    {
+        REQUIRE(!PropertyBatch::isActive());
+
+        owner->setA(1);
+        owner->setA(2);
+
+        REQUIRE(notifications == Array<String>({"a=1", "a=2"}));
+    }
+
+    SECTION("deferred and deduplicated")
+    {
+        {
+            PropertyBatch batch;
+
+            REQUIRE(PropertyBatch::isActive());
+
+            owner->setA(1);
+            owner->setB(10);
+            owner->setA(2);
+            owner->setA(3);
+
+            REQUIRE(notifications.empty());
+            REQUIRE(PropertyBatch::getPendingCount() == 2);
+        }
+
+        REQUIRE(!PropertyBatch::isActive());
+        REQUIRE(PropertyBatch::getPendingCount() == 0);
+
+        // one notification per property, in the order of the first change,
+        // with the final value.
+        REQUIRE(notifications == Array<String>({"a=3", "b=10"}));
+    }
+
+    SECTION("nested")
+    {
+        {
+            PropertyBatch outerBatch;
+
+            owner->setA(1);
+
+            {
+                PropertyBatch innerBatch;
+                owner->setB(1);
+                owner->setA(2);
+            }
+
+            REQUIRE(notifications.empty());
+        }
+
+        REQUIRE(notifications == Array<String>({"a=2", "b=1"}));
+    }
+
+    SECTION("changes from subscribers during delivery")
+    {
+        owner->aChanged().subscribe([owner](int value) { owner->setB(value * 10); });
+
+        {
+            PropertyBatch batch;
+            owner->setA(5);
+        }
+
+        REQUIRE(notifications == Array<String>({"a=5", "b=50"}));
+    }
+
+    SECTION("exception in subscriber")
+    {
+        owner->aChanged().subscribeParamless([]() { throw std::runtime_error("test"); });
+
+        {
+            PropertyBatch batch;
+            owner->setA(1);
+            owner->setB(2);
+        }
+
+        // the exception is logged and the other notifications are still
+        // delivered.
+        REQUIRE(notifications == Array<String>({"a=1", "b=2"}));
+    }
+
+    SECTION("owner kept alive")
+    {
+        {
+            PropertyBatch batch;
+            owner->setA(7);
+
+            owner = nullptr;
+        }
+
+        REQUIRE(notifications == Array<String>({"a=7"}));
+    }
+
+    SECTION("computed property")
+    {
+        int computeCount = 0;
+        P<ComputedProperty<int>> sum = newObj<ComputedProperty<int>>([owner, &computeCount](ComputedPropertyTracker &t) {
+            computeCount++;
+            return t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, a)) + t.read(BDN_PROPERTY_READ_ACCESSOR(*owner, b));
+        });
+
+        Array<int> sums;
+        sum->changed().subscribe([&sums](int value) { sums.add(value); });
+        REQUIRE(computeCount == 1);
+
+        {
+            PropertyBatch batch;
+            owner->setA(1);
+            owner->setB(2);
+            owner->setA(3);
+        }
+
+        // recomputed once, after all notifications were delivered
+        REQUIRE(computeCount == 2);
+        REQUIRE(sums == Array<int>({5}));
+    }
+}
+
+TEST_CASE("PropertyBatch-View")
+{
+    P<bdn::test::MockUiProvider> uiProvider = newObj<bdn::test::MockUiProvider>();
+    P<Window> window = newObj<Window>(uiProvider);
+
+    P<Button> button = newObj<Button>();
+    window->setContentView(button);
+
+    P<bdn::test::MockViewCore> core = cast<bdn::test::MockViewCore>(button->getViewCore());
+    REQUIRE(core != nullptr);
+
+    P<bdn::test::MockViewCore> windowCore = cast<bdn::test::MockViewCore>(window->getViewCore());
+    REQUIRE(windowCore != nullptr);
+
+    int paddingNotifications = 0;
+    button->paddingChanged().subscribeParamless([&paddingNotifications]() { paddingNotifications++; });
+
+    int sizingInfoInvalidatedBefore = core->getInvalidateSizingInfoCount();
+    int needLayoutBefore = core->getNeedLayoutCount();
+    int parentSizingInfoInvalidatedBefore = windowCore->getInvalidateSizingInfoCount();
+
+    {
+        PropertyBatch batch;
+
+        button->setPadding(UiMargin(1));
+        button->setPadding(UiMargin(2));
+        button->setPadding(UiMargin(3));
+        button->setMargin(UiMargin(4));
+        button->setMargin(UiMargin(5));
+        button->setHorizontalAlignment(View::HorizontalAlignment::center);
+        button->setVerticalAlignment(View::VerticalAlignment::bottom);
+
+        // the view core gets the new values immediately. Only the
+        // notifications and influences are deferred.
+        REQUIRE(core->getInvalidateSizingInfoCount() == sizingInfoInvalidatedBefore);
+        REQUIRE(core->getNeedLayoutCount() == needLayoutBefore);
+        REQUIRE(windowCore->getInvalidateSizingInfoCount() == parentSizingInfoInvalidatedBefore);
+        REQUIRE(paddingNotifications == 0);
+    }
+
+    REQUIRE(core->getInvalidateSizingInfoCount() == sizingInfoInvalidatedBefore + 1);
+    REQUIRE(core->getNeedLayoutCount() == needLayoutBefore + 1);
+    REQUIRE(paddingNotifications == 1);
+    REQUIRE(button->padding() == UiMargin(3));
+
+    // the parent got the sizing info invalidation from the child and the one
+    // caused by the margin change.
+    REQUIRE(windowCore->getInvalidateSizingInfoCount() <= parentSizingInfoInvalidatedBefore + 2);
+}
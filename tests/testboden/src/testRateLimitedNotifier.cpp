@@ -0,0 +1,207 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/RateLimitedNotifier.h>
+#include <bdn/SimpleNotifier.h>
+#include <bdn/ThreadSafeNotifier.h>
+#include <bdn/Array.h>
+#include <bdn/test/FakeTimeDispatcher.h>
+
+using namespace bdn;
+
+TEST_CASE("FakeTimeDispatcher")
+{
+    P<bdn::test::FakeTimeDispatcher> dispatcher = newObj<bdn::test::FakeTimeDispatcher>();
+
+    Array<String> calls;
+
+    dispatcher->enqueueInSeconds(1, [&calls, dispatcher]() { calls.add("1:" + std::to_string(dispatcher->getTime())); });
+    dispatcher->enqueue([&calls]() { calls.add("idle"); }, IDispatcher::Priority::idle);
+    dispatcher->enqueue([&calls]() { calls.add("normal"); });
+
+    REQUIRE(calls.empty());
+
+    REQUIRE(dispatcher->executeReady() == 2);
+    REQUIRE(calls == Array<String>({"normal", "idle"}));
+
+    dispatcher->advanceTime(0.5);
+    REQUIRE(calls.size() == 2);
+
+    dispatcher->advanceTime(2);
+    REQUIRE(calls.size() == 3);
+    REQUIRE(calls[2] == "1:" + std::to_string(1.0));
+    REQUIRE(dispatcher->getTime() == 2.5);
+
+    SECTION("timer")
+    {
+        int timerCalls = 0;
+        dispatcher->createTimer(0.25, [&timerCalls]() {
+            timerCalls++;
+            return timerCalls < 3;
+        });
+
+        dispatcher->advanceTime(10);
+        REQUIRE(timerCalls == 3);
+        REQUIRE(dispatcher->getPendingCount() == 0);
+    }
+}
+
+TEST_CASE("RateLimitedNotifier")
+{
+    P<bdn::test::FakeTimeDispatcher> dispatcher = newObj<bdn::test::FakeTimeDispatcher>();
+    P<SimpleNotifier<int>> source = newObj<SimpleNotifier<int>>();
+
+    Array<int> values;
+    Array<double> times;
+
+    auto subscribeRecorder = [&values, &times, dispatcher](INotifierBase<int> &notifier) {
+        notifier.subscribe([&values, &times, dispatcher](int value) {
+            values.add(value);
+            times.add(dispatcher->getTime());
+        });
+    };
+
+    SECTION("throttle")
+    {
+        P<INotifierBase<int>> throttled = throttle(*source, 1, dispatcher);
+        subscribeRecorder(*throttled);
+
+        source->notify(1);
+
+        // nothing is called synchronously
+        REQUIRE(values.empty());
+
+        // the first value is delivered right away
+        dispatcher->executeReady();
+        REQUIRE(values == Array<int>({1}));
+
+        source->notify(2);
+        source->notify(3);
+        dispatcher->advanceTime(0.5);
+        source->notify(4);
+        dispatcher->advanceTime(0.25);
+        REQUIRE(values == Array<int>({1}));
+
+        // at the end of the interval the latest value is delivered
+        dispatcher->advanceTime(0.25);
+        REQUIRE(values == Array<int>({1, 4}));
+        REQUIRE(times == Array<double>({0, 1}));
+
+        // quiet interval. The timer stops.
+        dispatcher->advanceTime(5);
+        REQUIRE(values == Array<int>({1, 4}));
+        REQUIRE(dispatcher->getPendingCount() == 0);
+
+        // the next value is delivered right away again
+        source->notify(5);
+        dispatcher->executeReady();
+        REQUIRE(values == Array<int>({1, 4, 5}));
+        REQUIRE(times == Array<double>({0, 1, 6}));
+
+        SECTION("continuous stream")
+        {
+            // one notification every 0.25 seconds for 4 seconds
+            for (int i = 0; i < 16; i++) {
+                source->notify(100 + i);
+                dispatcher->advanceTime(0.25);
+            }
+
+            // one delivery per second
+            REQUIRE(values.size() == 7);
+            REQUIRE(times == Array<double>({0, 1, 6, 7, 8, 9, 10}));
+            REQUIRE(values.back() == 115);
+        }
+    }
+
+    SECTION("debounce")
+    {
+        P<INotifierBase<int>> debounced = debounce(*source, 1, dispatcher);
+        subscribeRecorder(*debounced);
+
+        for (int i = 0; i < 10; i++) {
+            source->notify(i);
+            dispatcher->advanceTime(0.5);
+        }
+
+        // the source never was quiet for a full second
+        REQUIRE(values.empty());
+
+        dispatcher->advanceTime(2);
+
+        REQUIRE(values == Array<int>({9}));
+        REQUIRE(times[0] - 4.5 >= 1);
+        REQUIRE(times[0] - 4.5 <= 2);
+
+        REQUIRE(dispatcher->getPendingCount() == 0);
+    }
+
+    SECTION("sampleOnIdle")
+    {
+        P<INotifierBase<int>> sampled = sampleOnIdle(*source, dispatcher);
+        subscribeRecorder(*sampled);
+
+        bool normalItemExecuted = false;
+        dispatcher->enqueue([&normalItemExecuted, &values, source]() {
+            // the sample must not be delivered before normal items
+            REQUIRE(values.empty());
+            source->notify(3);
+            normalItemExecuted = true;
+        });
+
+        source->notify(1);
+        source->notify(2);
+
+        dispatcher->executeReady();
+
+        REQUIRE(normalItemExecuted);
+        REQUIRE(values == Array<int>({3}));
+    }
+
+    SECTION("reference arguments")
+    {
+        P<SimpleNotifier<const String &>> stringSource = newObj<SimpleNotifier<const String &>>();
+        P<INotifierBase<const String &>> throttled = throttle(*stringSource, 1, dispatcher);
+
+        Array<String> strings;
+        throttled->subscribe([&strings](const String &s) { strings.add(s); });
+
+        {
+            String temp = "hello";
+            stringSource->notify(temp);
+        }
+
+        dispatcher->executeReady();
+        REQUIRE(strings == Array<String>({"hello"}));
+    }
+
+    SECTION("adapter released")
+    {
+        P<INotifierBase<int>> throttled = throttle(*source, 1, dispatcher);
+        subscribeRecorder(*throttled);
+
+        throttled = nullptr;
+
+        // the weak subscription is removed
+        source->notify(1);
+        dispatcher->advanceTime(2);
+        REQUIRE(values.empty());
+    }
+
+    SECTION("notifications from other threads")
+    {
+        P<ThreadSafeNotifier<int>> threadSafeSource = newObj<ThreadSafeNotifier<int>>();
+        P<INotifierBase<int>> throttled = throttle(*threadSafeSource, 1, dispatcher);
+        subscribeRecorder(*throttled);
+
+        Thread::exec([threadSafeSource]() {
+            for (int i = 1; i <= 1000; i++)
+                threadSafeSource->notify(i);
+        })
+            .get();
+
+        dispatcher->advanceTime(2);
+
+        // all notifications happened before the first delivery
+        REQUIRE(values == Array<int>({1000}));
+    }
+}
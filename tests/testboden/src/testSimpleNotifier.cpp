@@ -427,4 +427,74 @@ TEST_CASE("SimpleNotifier")
             REQUIRE((gotParam3 == Array<String>{}));
         }
     }
+
+    SECTION("subscribe from inside notify")
+    {
+        Array<String> gotParam1;
+        Array<String> gotParam2;
+
+        P<INotifierSubscription> sub2;
+
+        P<INotifierSubscription> sub1 = notifier->subscribe([&gotParam1, &gotParam2, &sub2, notifier](String param) {
+            gotParam1.add(param);
+
+            if (sub2 == nullptr)
+                sub2 = notifier->subscribe([&gotParam2](String param) { gotParam2.add(param); });
+        });
+
+        notifier->notify("hello");
+
+        // subscribers that are added during a notification are not called by
+        // that notification
+        REQUIRE((gotParam1 == Array<String>{"hello"}));
+        REQUIRE(gotParam2.isEmpty());
+
+        notifier->notify("world");
+
+        REQUIRE((gotParam1 == Array<String>{"hello", "world"}));
+        REQUIRE((gotParam2 == Array<String>{"world"}));
+
+        SECTION("unsubscribe before added")
+        {
+            P<INotifierSubscription> sub3;
+
+            notifier->subscribe([&sub3, notifier](String param) {
+                if (sub3 == nullptr) {
+                    sub3 = notifier->subscribe([](String param) { REQUIRE(false); });
+
+                    // unsubscribing a subscription that is still pending
+                    // must work as well.
+                    notifier->unsubscribe(sub3);
+                }
+            });
+
+            notifier->notify("a");
+            notifier->notify("b");
+
+            REQUIRE((gotParam2 == Array<String>{"world", "a", "b"}));
+        }
+    }
+
+    SECTION("many subscribers with unsubscribe during notify")
+    {
+        Array<int> callCounts;
+        Array<P<INotifierSubscription>> subs;
+
+        for (int i = 0; i < 100; i++) {
+            callCounts.add(0);
+            subs.add(notifier->subscribe([&callCounts, &subs, notifier, i](String) {
+                callCounts[i]++;
+
+                // every subscriber unsubscribes the next odd subscriber
+                if (i % 2 == 0 && i + 1 < 100)
+                    notifier->unsubscribe(subs[i + 1]);
+            }));
+        }
+
+        notifier->notify("hello");
+        notifier->notify("world");
+
+        for (int i = 0; i < 100; i++)
+            REQUIRE(callCounts[i] == (i % 2 == 0 ? 2 : 0));
+    }
 }
@@ -0,0 +1,146 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StaticSignal.h>
+#include <bdn/Array.h>
+
+using namespace bdn;
+
+namespace
+{
+    struct StaticSignalTestListener
+    {
+        Array<String> *calls;
+        String name;
+
+        void onNotify(int value) { calls->add(name + ":" + std::to_string(value)); }
+    };
+
+    void staticSignalTestFunc(void *context, int value)
+    {
+        StaticSignalTestListener *listener = static_cast<StaticSignalTestListener *>(context);
+        listener->calls->add("func " + listener->name + ":" + std::to_string(value));
+    }
+}
+
+TEST_CASE("StaticSignal")
+{
+    StaticSignalN<3, int> signal;
+
+    Array<String> calls;
+    StaticSignalTestListener a{&calls, "a"};
+    StaticSignalTestListener b{&calls, "b"};
+    StaticSignalTestListener c{&calls, "c"};
+
+    REQUIRE(signal.getCapacity() == 3);
+    REQUIRE(signal.getListenerCount() == 0);
+
+    SECTION("no listeners") { signal.notify(1); }
+
+    SECTION("function and method")
+    {
+        signal.connect(&staticSignalTestFunc, &a);
+        signal.connectMethod<StaticSignalTestListener, &StaticSignalTestListener::onNotify>(&b);
+
+        REQUIRE(signal.getListenerCount() == 2);
+
+        signal.notify(7);
+        REQUIRE(calls == Array<String>({"func a:7", "b:7"}));
+
+        SECTION("disconnect")
+        {
+            signal.disconnect(&staticSignalTestFunc, &a);
+            REQUIRE(signal.getListenerCount() == 1);
+
+            signal.notify(8);
+            REQUIRE(calls == Array<String>({"func a:7", "b:7", "b:8"}));
+
+            signal.disconnectMethod<StaticSignalTestListener, &StaticSignalTestListener::onNotify>(&b);
+            REQUIRE(signal.getListenerCount() == 0);
+
+            signal.notify(9);
+            REQUIRE(calls.size() == 3);
+        }
+
+        SECTION("disconnect unknown")
+        {
+            signal.disconnect(&staticSignalTestFunc, &c);
+            REQUIRE(signal.getListenerCount() == 2);
+        }
+
+        SECTION("disconnectAll")
+        {
+            signal.disconnectAll();
+            signal.notify(9);
+            REQUIRE(calls.size() == 2);
+        }
+    }
+
+    SECTION("capacity exceeded")
+    {
+        signal.connect(&staticSignalTestFunc, &a);
+        signal.connect(&staticSignalTestFunc, &b);
+        signal.connect(&staticSignalTestFunc, &c);
+
+        REQUIRE_THROWS_PROGRAMMING_ERROR(signal.connect(&staticSignalTestFunc, &a));
+        REQUIRE(signal.getListenerCount() == 3);
+    }
+
+    SECTION("disconnect during notify")
+    {
+        struct Disconnector
+        {
+            StaticSignalN<3, int> *signal;
+            StaticSignalTestListener *toRemove;
+            Array<String> *calls;
+
+            void onNotify(int value)
+            {
+                calls->add("disconnector");
+                signal->disconnect(&staticSignalTestFunc, toRemove);
+            }
+        };
+
+        Disconnector disconnector{&signal, &c, &calls};
+
+        signal.connect(&staticSignalTestFunc, &a);
+        signal.connectMethod<Disconnector, &Disconnector::onNotify>(&disconnector);
+        signal.connect(&staticSignalTestFunc, &c);
+
+        signal.notify(1);
+
+        // c was disconnected before it was called
+        REQUIRE(calls == Array<String>({"func a:1", "disconnector"}));
+        REQUIRE(signal.getListenerCount() == 2);
+
+        signal.notify(2);
+        REQUIRE(calls == Array<String>({"func a:1", "disconnector", "func a:2", "disconnector"}));
+    }
+
+    SECTION("connect during notify")
+    {
+        struct Connector
+        {
+            StaticSignalN<3, int> *signal;
+            StaticSignalTestListener *toAdd;
+
+            void onNotify(int value)
+            {
+                if (signal->getListenerCount() < 2)
+                    signal->connect(&staticSignalTestFunc, toAdd);
+            }
+        };
+
+        Connector connector{&signal, &a};
+        signal.connectMethod<Connector, &Connector::onNotify>(&connector);
+
+        signal.notify(1);
+
+        // the new listener is only called by the next notification
+        REQUIRE(calls.empty());
+        REQUIRE(signal.getListenerCount() == 2);
+
+        signal.notify(2);
+        REQUIRE(calls == Array<String>({"func a:2"}));
+    }
+}
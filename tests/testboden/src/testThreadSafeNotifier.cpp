@@ -3,6 +3,10 @@
 
 #include <bdn/ThreadSafeNotifier.h>
 #include <bdn/DanglingFunctionError.h>
+#include <bdn/NotificationBatch.h>
+#include <bdn/Array.h>
+
+#include <atomic>
 
 using namespace bdn;
 
@@ -645,4 +649,142 @@ TEST_CASE("ThreadSafeNotifier")
             };
         }
     }
+
+#if BDN_HAVE_THREADS
+    SECTION("concurrent notify and subscription changes")
+    {
+        P<ThreadSafeNotifier<int>> notifier = newObj<ThreadSafeNotifier<int>>();
+
+        std::atomic<int64_t> permanentCallSum(0);
+        std::atomic<int64_t> temporaryCallCount(0);
+
+        notifier->subscribe([&permanentCallSum](int value) { permanentCallSum += value; });
+
+        const int threadCount = 4;
+        const int notifyCountPerThread = 20000;
+
+        std::vector<std::future<void>> results;
+        for (int i = 0; i < threadCount; i++) {
+            results.push_back(Thread::exec([notifier, notifyCountPerThread]() {
+                for (int n = 0; n < notifyCountPerThread; n++)
+                    notifier->notify(1);
+            }));
+        }
+
+        // subscribe and unsubscribe while the other threads are notifying.
+        // Each change publishes a new subscriber snapshot.
+        for (int i = 0; i < 2000; i++) {
+            P<INotifierSubscription> sub = notifier->subscribe([&temporaryCallCount](int) { temporaryCallCount++; });
+            notifier->unsubscribe(sub);
+        }
+
+        for (auto &result : results)
+            result.get();
+
+        // the permanent subscriber must have received every notification
+        // exactly once.
+        REQUIRE(permanentCallSum == threadCount * notifyCountPerThread);
+    }
+#endif
+
+    SECTION("coalesce")
+    {
+        P<ThreadSafeNotifier<int>> notifier = newObj<ThreadSafeNotifier<int>>();
+        REQUIRE(notifier->getPostingMode() == ThreadSafeNotifier<int>::PostingMode::individual);
+
+        notifier->setPostingMode(ThreadSafeNotifier<int>::PostingMode::coalesce);
+        REQUIRE(notifier->getPostingMode() == ThreadSafeNotifier<int>::PostingMode::coalesce);
+
+        P<Array<int>> values = newObj<Array<int>>();
+        notifier->subscribe([values](int value) { values->add(value); });
+
+        for (int i = 1; i <= 100; i++)
+            notifier->postNotification(i);
+
+        CONTINUE_SECTION_WHEN_IDLE(notifier, values)
+        {
+            // only the latest value should have been delivered
+            REQUIRE(values->size() == 1);
+            REQUIRE((*values)[0] == 100);
+
+            SECTION("postAgain")
+            {
+                notifier->postNotification(17);
+
+                CONTINUE_SECTION_WHEN_IDLE(notifier, values)
+                {
+                    REQUIRE(values->size() == 2);
+                    REQUIRE((*values)[1] == 17);
+                };
+            }
+
+            SECTION("postDuringNotification")
+            {
+                notifier->subscribe([notifier](int value) {
+                    if (value == 1)
+                        notifier->postNotification(2);
+                });
+
+                notifier->postNotification(1);
+
+                CONTINUE_SECTION_WHEN_IDLE(notifier, values)
+                {
+                    // the notification posted during the delivery must have
+                    // been delivered as well.
+                    REQUIRE(values->size() == 3);
+                    REQUIRE((*values)[1] == 1);
+                    REQUIRE((*values)[2] == 2);
+                };
+            }
+        };
+    }
+
+    SECTION("postingBatch")
+    {
+        P<NotificationBatch> batch = newObj<NotificationBatch>();
+
+        P<ThreadSafeNotifier<int>> notifier1 = newObj<ThreadSafeNotifier<int>>();
+        P<ThreadSafeNotifier<String>> notifier2 = newObj<ThreadSafeNotifier<String>>();
+
+        notifier1->setPostingBatch(batch);
+        notifier2->setPostingBatch(batch);
+        REQUIRE(notifier1->getPostingBatch() == batch);
+
+        P<Array<String>> calls = newObj<Array<String>>();
+        notifier1->subscribe([calls](int value) { calls->add("1:" + std::to_string(value)); });
+        notifier2->subscribe([calls](String value) { calls->add("2:" + value); });
+
+        notifier1->postNotification(1);
+        notifier2->postNotification("a");
+        notifier1->postNotification(2);
+
+        REQUIRE(batch->getPendingCount() == 3);
+        REQUIRE(calls->size() == 0);
+
+        SECTION("individual")
+        {
+            CONTINUE_SECTION_WHEN_IDLE(batch, calls)
+            {
+                REQUIRE(batch->getPendingCount() == 0);
+                REQUIRE(*calls == (Array<String>{"1:1", "2:a", "1:2"}));
+            };
+        }
+
+        SECTION("coalesce")
+        {
+            notifier1->setPostingMode(ThreadSafeNotifier<int>::PostingMode::coalesce);
+
+            notifier1->postNotification(3);
+            notifier1->postNotification(4);
+
+            // the first coalesced notification adds a delivery to the batch.
+            // The second one only updates the pending value.
+            REQUIRE(batch->getPendingCount() == 4);
+
+            CONTINUE_SECTION_WHEN_IDLE(batch, calls)
+            {
+                REQUIRE(*calls == (Array<String>{"1:1", "2:a", "1:2", "1:4"}));
+            };
+        }
+    }
 }
@@ -0,0 +1,103 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/ViewLayout.h>
+#include <bdn/ColumnView.h>
+#include <bdn/Button.h>
+#include <bdn/Window.h>
+
+#include <bdn/test/MockUiProvider.h>
+
+using namespace bdn;
+
+class TestViewLayoutData : public ViewLayout::ViewLayoutData
+{
+  public:
+    void applyTo(View *view) const override
+    {
+        ViewLayout::ViewLayoutData::applyTo(view);
+
+        cast<Button>(view)->setLabel("applied");
+    }
+};
+
+TEST_CASE("ViewLayout")
+{
+    P<bdn::test::MockUiProvider> uiProvider = newObj<bdn::test::MockUiProvider>();
+    P<Window> window = newObj<Window>(uiProvider);
+
+    P<ColumnView> container = newObj<ColumnView>();
+    window->setContentView(container);
+
+    P<Button> button1 = newObj<Button>();
+    P<Button> button2 = newObj<Button>();
+    container->addChildView(button1);
+    container->addChildView(button2);
+
+    CONTINUE_SECTION_WHEN_IDLE(window, container, button1, button2)
+    {
+        P<ViewLayout> layout = newObj<ViewLayout>();
+
+        SECTION("child bounds")
+        {
+            layout->reserveChildren(2);
+            layout->setChildBounds(1, button2, Rect(30, 60, 90, 120));
+
+            REQUIRE(layout->getChildCount() == 2);
+            REQUIRE(layout->getChildView(0) == nullptr);
+            REQUIRE(layout->getChildView(1) == button2);
+
+            Rect bounds;
+            REQUIRE(!layout->getChildBounds(0, bounds));
+            REQUIRE(bounds == Rect());
+            REQUIRE(layout->getChildBounds(1, bounds));
+            REQUIRE(bounds == Rect(30, 60, 90, 120));
+
+            Point button1Position = button1->position();
+
+            layout->applyTo(container);
+
+            REQUIRE(button1->position() == button1Position);
+            REQUIRE(button2->position() == Point(30, 60));
+            REQUIRE(button2->size() == Size(90, 120));
+
+            SECTION("getViewLayoutData")
+            {
+                REQUIRE(layout->getViewLayoutData(button1) == nullptr);
+
+                P<ViewLayout::ViewLayoutData> data = layout->getViewLayoutData(button2);
+                REQUIRE(data != nullptr);
+                REQUIRE(data->getBounds(bounds));
+                REQUIRE(bounds == Rect(30, 60, 90, 120));
+            }
+        }
+
+        SECTION("removed child is not modified")
+        {
+            layout->setChildBounds(0, button1, Rect(30, 60, 90, 120));
+
+            container->removeChildView(button1);
+
+            Point button1Position = button1->position();
+
+            layout->applyTo(container);
+
+            REQUIRE(button1->position() == button1Position);
+        }
+
+        SECTION("custom layout data")
+        {
+            layout->setChildBounds(0, button1, Rect(30, 60, 90, 120));
+
+            P<TestViewLayoutData> data = newObj<TestViewLayoutData>();
+            data->setBounds(Rect(3, 6, 9, 12));
+            layout->setViewLayoutData(button2, data);
+
+            layout->applyTo(container);
+
+            REQUIRE(button1->position() == Point(30, 60));
+            REQUIRE(button2->position() == Point(3, 6));
+            REQUIRE(button2->label() == "applied");
+        }
+    };
+}
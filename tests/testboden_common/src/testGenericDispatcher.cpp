@@ -4,6 +4,9 @@
 #include <bdn/test/testDispatcher.h>
 
 #include <bdn/GenericDispatcher.h>
+#include <bdn/StopWatch.h>
+
+#include <atomic>
 
 using namespace bdn;
 
@@ -33,4 +36,147 @@ TEST_CASE("GenericDispatcher")
     }
 }
 
+static void waitUntilIdle(GenericDispatcher *dispatcher)
+{
+    StopWatch watch;
+    while (true) {
+        GenericDispatcher::Statistics stats = dispatcher->getStatistics();
+        if (stats.queuedItemCount == 0 && stats.executingItemCount == 0)
+            break;
+
+        REQUIRE(watch.getMillis() < 10000);
+        Thread::sleepMillis(10);
+    }
+}
+
+TEST_CASE("GenericDispatcher.WorkerPool")
+{
+    P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+
+    SECTION("allItemsExecuted")
+    {
+        P<GenericDispatcher::WorkerPool> pool = newObj<GenericDispatcher::WorkerPool>(dispatcher, 4);
+        REQUIRE(pool->getThreadCount() == 4);
+
+        std::atomic<int> callCount(0);
+        for (int i = 0; i < 1000; i++)
+            dispatcher->enqueue([&callCount]() { callCount++; });
+
+        waitUntilIdle(dispatcher);
+
+        REQUIRE(callCount == 1000);
+
+        GenericDispatcher::Statistics stats = dispatcher->getStatistics();
+        REQUIRE(stats.executedItemCount == 1000);
+        REQUIRE(stats.maxQueuedItemCount >= 1);
+        REQUIRE(stats.maxWaitSeconds >= stats.averageWaitSeconds);
+
+        pool->stop();
+    }
+
+    SECTION("parallelExecution")
+    {
+        P<GenericDispatcher::WorkerPool> pool = newObj<GenericDispatcher::WorkerPool>(dispatcher, 4);
+
+        std::atomic<int> runningCount(0);
+        std::atomic<int> maxRunningCount(0);
+
+        for (int i = 0; i < 8; i++) {
+            dispatcher->enqueue([&runningCount, &maxRunningCount]() {
+                int running = ++runningCount;
+
+                int prevMax = maxRunningCount;
+                while (running > prevMax && !maxRunningCount.compare_exchange_weak(prevMax, running)) {
+                }
+
+                Thread::sleepMillis(200);
+                runningCount--;
+            });
+        }
+
+        waitUntilIdle(dispatcher);
+
+        // the items must have overlapped
+        REQUIRE(maxRunningCount > 1);
+        REQUIRE(maxRunningCount <= 4);
+    }
+
+    SECTION("serialKey")
+    {
+        P<GenericDispatcher::WorkerPool> pool = newObj<GenericDispatcher::WorkerPool>(dispatcher, 4);
+
+        std::atomic<int> runningCount[2];
+        runningCount[0] = 0;
+        runningCount[1] = 0;
+        std::atomic<bool> overlapped(false);
+
+        std::vector<int> order[2];
+
+        for (int i = 0; i < 20; i++) {
+            int keyIndex = i % 2;
+            dispatcher->enqueueSerial(keyIndex == 0 ? "a" : "b", [&runningCount, &overlapped, &order, keyIndex, i]() {
+                if (++runningCount[keyIndex] > 1)
+                    overlapped = true;
+
+                // not protected by a mutex. The serial key must ensure that
+                // there is no concurrent access.
+                order[keyIndex].push_back(i);
+
+                Thread::sleepMillis(5);
+                runningCount[keyIndex]--;
+            });
+        }
+
+        waitUntilIdle(dispatcher);
+
+        REQUIRE(!overlapped);
+
+        for (int keyIndex = 0; keyIndex < 2; keyIndex++) {
+            REQUIRE(order[keyIndex].size() == 10);
+            for (int i = 0; i < 10; i++)
+                REQUIRE(order[keyIndex][i] == i * 2 + keyIndex);
+        }
+    }
+
+    SECTION("emptySerialKey")
+    {
+        REQUIRE_THROWS_AS(dispatcher->enqueueSerial("", []() {}), InvalidArgumentError);
+    }
+
+    SECTION("priority")
+    {
+        // items are queued before the pool is started, so the order in which
+        // a single thread takes them from the queue is deterministic.
+        std::vector<String> order;
+
+        dispatcher->enqueue([&order]() { order.push_back("idle"); }, IDispatcher::Priority::idle);
+        dispatcher->enqueue([&order]() { order.push_back("normal"); });
+
+        REQUIRE(dispatcher->getStatistics().queuedItemCount == 2);
+
+        P<GenericDispatcher::WorkerPool> pool = newObj<GenericDispatcher::WorkerPool>(dispatcher, 1);
+
+        waitUntilIdle(dispatcher);
+
+        REQUIRE(order.size() == 2);
+        REQUIRE(order[0] == "normal");
+        REQUIRE(order[1] == "idle");
+    }
+
+    SECTION("stopLeavesQueuedItems")
+    {
+        P<GenericDispatcher::WorkerPool> pool = newObj<GenericDispatcher::WorkerPool>(dispatcher, 2);
+        pool->stop();
+
+        int64_t queuedBefore = dispatcher->getStatistics().queuedItemCount;
+
+        dispatcher->enqueue([]() {});
+        Thread::sleepMillis(100);
+
+        REQUIRE(dispatcher->getStatistics().queuedItemCount == queuedBefore + 1);
+    }
+
+    dispatcher->dispose();
+}
+
 #endif
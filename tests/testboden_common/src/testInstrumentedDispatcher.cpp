@@ -0,0 +1,100 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/test/testDispatcher.h>
+
+#include <bdn/GenericDispatcher.h>
+#include <bdn/InstrumentedDispatcher.h>
+
+using namespace bdn;
+
+#if BDN_HAVE_THREADS
+
+TEST_CASE("InstrumentedDispatcher")
+{
+    static P<GenericDispatcher> innerDispatcher = newObj<GenericDispatcher>();
+    static P<Thread> thread = newObj<Thread>(newObj<GenericDispatcher::ThreadRunnable>(innerDispatcher));
+    static P<InstrumentedDispatcher> dispatcher = newObj<InstrumentedDispatcher>(innerDispatcher);
+
+    SECTION("conformance")
+    {
+        bool enableTimingTests = false;
+#ifdef BDN_ENABLE_TIMING_TESTS
+        enableTimingTests = true;
+#endif
+
+        // the instrumentation must not change the behaviour of the
+        // dispatcher.
+        bdn::test::testDispatcher(dispatcher, thread->getId(), enableTimingTests);
+    }
+
+    SECTION("statistics")
+    {
+        dispatcher->reset();
+
+        // block the dispatcher thread so that the following items queue up.
+        dispatcher->enqueue([]() { Thread::sleepMillis(300); });
+
+        for (int i = 0; i < 10; i++)
+            dispatcher->enqueue([]() {});
+        dispatcher->enqueue([]() {}, IDispatcher::Priority::idle);
+
+        REQUIRE(dispatcher->getSnapshot().normal.maxQueuedItemCount >= 10);
+
+        CONTINUE_SECTION_AFTER_RUN_SECONDS(1)
+        {
+            InstrumentedDispatcher::Snapshot snapshot = dispatcher->getSnapshot();
+
+            REQUIRE(snapshot.normal.queuedItemCount == 0);
+            REQUIRE(snapshot.normal.waitTime.count == 11);
+            REQUIRE(snapshot.normal.executionTime.count == 11);
+
+            // the blocking item took at least 300 ms and the others had to
+            // wait for it.
+            REQUIRE(snapshot.normal.executionTime.maxNanos >= 290 * 1000 * 1000);
+            REQUIRE(snapshot.normal.waitTime.maxNanos >= 200 * 1000 * 1000);
+
+            REQUIRE(snapshot.idle.queuedItemCount == 0);
+            REQUIRE(snapshot.idle.maxQueuedItemCount == 1);
+            REQUIRE(snapshot.idle.waitTime.count == 1);
+            REQUIRE(snapshot.idle.waitTime.maxNanos >= 200 * 1000 * 1000);
+
+            dispatcher->logSnapshot("InstrumentedDispatcher test");
+        };
+    }
+
+    SECTION("timerLateness")
+    {
+        dispatcher->reset();
+
+        dispatcher->enqueueInSeconds(0.1, []() {});
+
+        // keep the dispatcher busy past the scheduled time of the delayed
+        // item.
+        dispatcher->enqueue([]() { Thread::sleepMillis(300); });
+
+        CONTINUE_SECTION_AFTER_RUN_SECONDS(1)
+        {
+            InstrumentedDispatcher::Snapshot snapshot = dispatcher->getSnapshot();
+
+            REQUIRE(snapshot.timerLateness.count == 1);
+            REQUIRE(snapshot.timerLateness.maxNanos >= 150 * 1000 * 1000);
+
+            // delayed items are not counted as waiting items
+            REQUIRE(snapshot.normal.waitTime.count == 1);
+            REQUIRE(snapshot.normal.executionTime.count == 2);
+        };
+    }
+
+    SECTION("cleanup")
+    {
+        // this is a dummy section that is used to clean up the dispatcher and
+        // thread we created.
+        thread->stop(Thread::ExceptionIgnore);
+        thread = nullptr;
+        dispatcher = nullptr;
+        innerDispatcher = nullptr;
+    }
+}
+
+#endif
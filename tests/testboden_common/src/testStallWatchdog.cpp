@@ -0,0 +1,160 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/GenericDispatcher.h>
+#include <bdn/StallWatchdog.h>
+#include <bdn/DispatchOrigin.h>
+#include <bdn/StopWatch.h>
+
+#include <cmath>
+
+using namespace bdn;
+
+TEST_CASE("DispatchOrigin")
+{
+    SECTION("noScope")
+    REQUIRE(!DispatchOrigin::getCurrent().isKnown());
+
+    SECTION("scope")
+    {
+        {
+            BDN_DISPATCH_ORIGIN_SCOPE();
+            int expectedLine = __LINE__ - 1;
+
+            DispatchOrigin origin = DispatchOrigin::getCurrent();
+            REQUIRE(origin.isKnown());
+            REQUIRE(origin.line == expectedLine);
+            REQUIRE(origin.toString() == "testStallWatchdog.cpp:" + std::to_string(expectedLine));
+
+            {
+                DispatchOrigin::Scope innerScope(DispatchOrigin("inner.cpp", 17));
+                REQUIRE(DispatchOrigin::getCurrent().toString() == "inner.cpp:17");
+            }
+
+            REQUIRE(DispatchOrigin::getCurrent().line == expectedLine);
+        }
+
+        REQUIRE(!DispatchOrigin::getCurrent().isKnown());
+    }
+}
+
+#if BDN_HAVE_THREADS
+
+static void waitForDispatcherIdle(GenericDispatcher *dispatcher)
+{
+    StopWatch watch;
+    while (dispatcher->getActivity().executing || dispatcher->getStatistics().queuedItemCount > 0) {
+        REQUIRE(watch.getMillis() < 10000);
+        Thread::sleepMillis(10);
+    }
+}
+
+TEST_CASE("GenericDispatcher.getActivity")
+{
+    P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+
+    REQUIRE(!dispatcher->getActivity().executing);
+    REQUIRE(dispatcher->getActivity().itemSequenceNumber == 0);
+
+    GenericDispatcher::Activity activityInItem;
+    int expectedLine;
+
+    {
+        BDN_DISPATCH_ORIGIN_SCOPE();
+        expectedLine = __LINE__ - 1;
+
+        dispatcher->enqueue([dispatcher, &activityInItem]() { activityInItem = dispatcher->getActivity(); });
+    }
+
+    dispatcher->executeNext();
+
+    REQUIRE(activityInItem.executing);
+    REQUIRE(activityInItem.itemSequenceNumber == 1);
+    REQUIRE(activityInItem.origin.line == expectedLine);
+
+    REQUIRE(!dispatcher->getActivity().executing);
+
+    // items enqueued without a scope get the type of the function object as
+    // their origin.
+    dispatcher->enqueue([dispatcher, &activityInItem]() { activityInItem = dispatcher->getActivity(); });
+    dispatcher->executeNext();
+
+    REQUIRE(activityInItem.itemSequenceNumber == 2);
+    REQUIRE(activityInItem.origin.file == nullptr);
+    REQUIRE(activityInItem.origin.callableTypeName != nullptr);
+
+    dispatcher->dispose();
+}
+
+TEST_CASE("StallWatchdog")
+{
+    P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+    P<Thread> thread = newObj<Thread>(newObj<GenericDispatcher::ThreadRunnable>(dispatcher));
+
+    P<StallWatchdog> watchdog = newObj<StallWatchdog>(dispatcher, 0.05);
+    REQUIRE(watchdog->getBudgetSeconds() == 0.05);
+
+    SECTION("noStall")
+    {
+        for (int i = 0; i < 10; i++)
+            dispatcher->enqueue([]() { Thread::sleepMillis(5); });
+
+        waitForDispatcherIdle(dispatcher);
+        Thread::sleepMillis(100);
+
+        REQUIRE(watchdog->getStatistics().stallCount == 0);
+    }
+
+    SECTION("stall")
+    {
+        int expectedLine;
+
+        {
+            BDN_DISPATCH_ORIGIN_SCOPE();
+            expectedLine = __LINE__ - 1;
+
+            dispatcher->enqueue([]() { Thread::sleepMillis(300); });
+        }
+
+        waitForDispatcherIdle(dispatcher);
+        Thread::sleepMillis(100);
+
+        StallWatchdog::Statistics statistics = watchdog->getStatistics();
+
+        String expectedOrigin = "testStallWatchdog.cpp:" + std::to_string(expectedLine);
+
+        REQUIRE(statistics.stallCount == 1);
+        REQUIRE(statistics.maxStallSeconds >= 0.2);
+        REQUIRE(statistics.maxStallSeconds <= 0.5);
+        REQUIRE(std::abs(statistics.totalStallSeconds - statistics.maxStallSeconds) < 0.001);
+        REQUIRE(statistics.maxStallOrigin == expectedOrigin);
+        REQUIRE(statistics.stallCountByOrigin.size() == 1);
+        REQUIRE(statistics.stallCountByOrigin[expectedOrigin] == 1);
+
+        watchdog->logStatistics();
+    }
+
+    SECTION("multipleStalls")
+    {
+        for (int i = 0; i < 3; i++)
+            dispatcher->enqueue([]() { Thread::sleepMillis(150); });
+
+        waitForDispatcherIdle(dispatcher);
+        Thread::sleepMillis(100);
+
+        StallWatchdog::Statistics statistics = watchdog->getStatistics();
+
+        REQUIRE(statistics.stallCount == 3);
+        REQUIRE(statistics.totalStallSeconds >= 0.3);
+    }
+
+    watchdog->stop();
+
+    // stop can be called multiple times
+    watchdog->stop();
+
+    thread->stop(Thread::ExceptionIgnore);
+    dispatcher->dispose();
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/LayoutCoordinator.h>
+#include <bdn/ColumnView.h>
+#include <bdn/Button.h>
+#include <bdn/test/MockUiProvider.h>
+#include <bdn/test/benchmark.h>
+
+using namespace bdn;
+
+class LayoutCoordinatorForBenchmark : public LayoutCoordinator
+{
+  public:
+    using LayoutCoordinator::updateNow;
+};
+
+static void benchmarkLayoutPass(const String &treeName, const Array<P<View>> &views)
+{
+    P<LayoutCoordinatorForBenchmark> coord = newObj<LayoutCoordinatorForBenchmark>();
+
+    const int64_t passCount = 20;
+
+    double nanosPerPass = bdn::test::measureNanosPerCall(passCount, [coord, &views]() {
+        // register all views in reverse order (deepest first), which is the
+        // worst case for the parent-first ordering.
+        for (auto it = views.rbegin(); it != views.rend(); ++it)
+            coord->viewNeedsLayout(*it);
+
+        coord->updateNow();
+    });
+
+    bdn::test::logBenchmarkResult("LayoutCoordinator pass with " + std::to_string(views.size()) + " dirty views (" +
+                                      treeName + ")",
+                                  nanosPerPass);
+    bdn::test::logBenchmarkResult("LayoutCoordinator per dirty view (" + treeName + ")",
+                                  nanosPerPass / views.size());
+}
+
+TEST_CASE("LayoutCoordinatorBenchmark")
+{
+    P<bdn::test::MockUiProvider> uiProvider = newObj<bdn::test::MockUiProvider>();
+
+    P<Window> window = newObj<Window>(uiProvider);
+
+    Array<P<View>> views;
+    views.add(window);
+
+    SECTION("deep")
+    {
+        P<ContainerView> parent = newObj<ColumnView>();
+        window->setContentView(parent);
+        views.add(parent);
+
+        for (int i = 0; i < 200; i++) {
+            P<ColumnView> child = newObj<ColumnView>();
+            parent->addChildView(child);
+            views.add(child);
+            parent = child;
+        }
+
+        // wait for the initial layout to finish
+        CONTINUE_SECTION_WHEN_IDLE(window, views) { benchmarkLayoutPass("deep", views); };
+    }
+
+    SECTION("wide")
+    {
+        P<ColumnView> container = newObj<ColumnView>();
+        window->setContentView(container);
+        views.add(container);
+
+        for (int i = 0; i < 1000; i++) {
+            P<Button> child = newObj<Button>();
+            container->addChildView(child);
+            views.add(child);
+        }
+
+        CONTINUE_SECTION_WHEN_IDLE(window, views) { benchmarkLayoutPass("wide", views); };
+    }
+}
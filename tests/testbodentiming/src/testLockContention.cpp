@@ -0,0 +1,89 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/FastMutex.h>
+#include <bdn/SpinLock.h>
+#include <bdn/Signal.h>
+#include <bdn/Thread.h>
+#include <bdn/test/benchmark.h>
+
+#include <mutex>
+
+using namespace bdn;
+
+#if BDN_HAVE_THREADS
+
+template <class MutexType> void benchmarkLockContention(const String &mutexName)
+{
+    int maxThreadCount = (int)std::thread::hardware_concurrency() * 2;
+    if (maxThreadCount < 2)
+        maxThreadCount = 2;
+    if (maxThreadCount > 16)
+        maxThreadCount = 16;
+
+    const int64_t totalLockCount = 400000;
+
+    for (int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2) {
+        MutexType mutex;
+        int64_t counter = 0;
+
+        double nanosPerLock =
+            bdn::test::measureParallelNanosPerCall(threadCount, totalLockCount / threadCount, [&mutex, &counter](int) {
+                mutex.lock();
+                // a tiny critical section, like the ones in notifiers and
+                // dispatchers.
+                counter++;
+                mutex.unlock();
+            });
+
+        REQUIRE(counter == (totalLockCount / threadCount) * threadCount);
+
+        bdn::test::logBenchmarkResult(mutexName + " lock+unlock with " + std::to_string(threadCount) + " thread(s)",
+                                      nanosPerLock);
+    }
+}
+
+TEST_CASE("LockContention")
+{
+    SECTION("Mutex")
+    benchmarkLockContention<Mutex>("Mutex");
+
+    SECTION("std::mutex")
+    benchmarkLockContention<std::mutex>("std::mutex");
+
+    SECTION("FastMutex")
+    benchmarkLockContention<FastMutex>("FastMutex");
+
+    SECTION("SpinLock")
+    benchmarkLockContention<SpinLock>("SpinLock");
+}
+
+TEST_CASE("SignalHandoff")
+{
+    // two threads pass control back and forth via two signals. This measures
+    // the latency of a wakeup.
+    P<Signal> pingSignal = newObj<Signal>();
+    P<Signal> pongSignal = newObj<Signal>();
+
+    const int roundTripCount = 20000;
+
+    std::future<void> result = Thread::exec([pingSignal, pongSignal, roundTripCount]() {
+        for (int i = 0; i < roundTripCount; i++) {
+            pingSignal->wait();
+            pingSignal->clear();
+            pongSignal->set();
+        }
+    });
+
+    double nanosPerRoundTrip = bdn::test::measureNanosPerCall(roundTripCount, [pingSignal, pongSignal]() {
+        pingSignal->set();
+        pongSignal->wait();
+        pongSignal->clear();
+    });
+
+    result.get();
+
+    bdn::test::logBenchmarkResult("Signal round trip between two threads", nanosPerRoundTrip);
+}
+
+#endif
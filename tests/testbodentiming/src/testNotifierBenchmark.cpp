@@ -0,0 +1,168 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/SimpleNotifier.h>
+#include <bdn/ThreadSafeNotifier.h>
+#include <bdn/NotifierBase.h>
+#include <bdn/FastMutex.h>
+#include <bdn/StaticSignal.h>
+#include <bdn/test/benchmark.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace bdn;
+
+template <class NotifierType>
+static void benchmarkNotify(const String &notifierName, P<NotifierType> notifier, int subscriberCount)
+{
+    int64_t callCount = 0;
+
+    for (int i = 0; i < subscriberCount; i++)
+        notifier->subscribe([&callCount](int value) { callCount += value; });
+
+    // keep the total number of subscriber calls roughly constant
+    int64_t notifyCount = 2000000 / subscriberCount;
+
+    double nanosPerNotify = bdn::test::measureNanosPerCall(notifyCount, [notifier]() { notifier->notify(1); });
+
+    REQUIRE(callCount == notifyCount * subscriberCount);
+
+    bdn::test::logBenchmarkResult(notifierName + " notify with " + std::to_string(subscriberCount) +
+                                      " subscriber(s)",
+                                  nanosPerNotify);
+}
+
+template <class NotifierType> static void benchmarkNotifier(const String &notifierName)
+{
+    SECTION("1 subscriber")
+    benchmarkNotify<NotifierType>(notifierName, newObj<NotifierType>(), 1);
+
+    SECTION("10 subscribers")
+    benchmarkNotify<NotifierType>(notifierName, newObj<NotifierType>(), 10);
+
+    SECTION("1000 subscribers")
+    benchmarkNotify<NotifierType>(notifierName, newObj<NotifierType>(), 1000);
+}
+
+TEST_CASE("NotifierBenchmark")
+{
+    SECTION("SimpleNotifier")
+    benchmarkNotifier<SimpleNotifier<int>>("SimpleNotifier");
+
+    SECTION("ThreadSafeNotifier")
+    benchmarkNotifier<ThreadSafeNotifier<int>>("ThreadSafeNotifier");
+}
+
+static void addToCallCount(void *context, int value) { *static_cast<int64_t *>(context) += value; }
+
+static void benchmarkStaticSignalNotify(int listenerCount)
+{
+    StaticSignalN<4, int> signal;
+
+    int64_t callCount = 0;
+    for (int i = 0; i < listenerCount; i++)
+        signal.connect(&addToCallCount, &callCount);
+
+    int64_t notifyCount = 2000000 / listenerCount;
+
+    double nanosPerNotify = bdn::test::measureNanosPerCall(notifyCount, [&signal]() { signal.notify(1); });
+
+    REQUIRE(callCount == notifyCount * listenerCount);
+
+    bdn::test::logBenchmarkResult("StaticSignal notify with " + std::to_string(listenerCount) + " listener(s)",
+                                  nanosPerNotify);
+}
+
+TEST_CASE("StaticSignalBenchmark")
+{
+    // StaticSignal is meant for signals with a handful of listeners. So we
+    // compare it to SimpleNotifier with the same (small) numbers.
+    SECTION("StaticSignal")
+    {
+        SECTION("1 listener")
+        benchmarkStaticSignalNotify(1);
+
+        SECTION("4 listeners")
+        benchmarkStaticSignalNotify(4);
+    }
+
+    SECTION("SimpleNotifier")
+    {
+        SECTION("1 subscriber")
+        benchmarkNotify<SimpleNotifier<int>>("SimpleNotifier", newObj<SimpleNotifier<int>>(), 1);
+
+        SECTION("4 subscribers")
+        benchmarkNotify<SimpleNotifier<int>>("SimpleNotifier", newObj<SimpleNotifier<int>>(), 4);
+    }
+}
+
+#if BDN_HAVE_THREADS
+
+/** The previous ThreadSafeNotifier implementation (a mutex protected
+   subscriber list), for comparison.*/
+class LockingNotifier : public NotifierBase<FastMutex, int>
+{
+  public:
+    void notify(int value) { doNotify(value); }
+};
+
+template <class NotifierType>
+static void benchmarkParallelNotify(const String &notifierName, int subscriberCount)
+{
+    int maxThreadCount = (int)std::thread::hardware_concurrency() * 2;
+    if (maxThreadCount < 2)
+        maxThreadCount = 2;
+    if (maxThreadCount > 16)
+        maxThreadCount = 16;
+
+    const int64_t totalNotifyCount = 400000 / subscriberCount;
+
+    for (int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2) {
+        P<NotifierType> notifier = newObj<NotifierType>();
+
+        std::atomic<int64_t> callCount(0);
+        for (int i = 0; i < subscriberCount; i++)
+            notifier->subscribe([&callCount](int value) { callCount.fetch_add(value, std::memory_order_relaxed); });
+
+        double nanosPerNotify = bdn::test::measureParallelNanosPerCall(
+            threadCount, totalNotifyCount / threadCount, [notifier](int) { notifier->notify(1); });
+
+        REQUIRE(callCount == (totalNotifyCount / threadCount) * threadCount * subscriberCount);
+
+        bdn::test::logBenchmarkResult(notifierName + " notify with " + std::to_string(subscriberCount) +
+                                          " subscriber(s), " + std::to_string(threadCount) + " thread(s)",
+                                      nanosPerNotify);
+    }
+}
+
+TEST_CASE("NotifierParallelBenchmark")
+{
+    SECTION("ThreadSafeNotifier")
+    {
+        SECTION("1 subscriber")
+        {
+            benchmarkParallelNotify<ThreadSafeNotifier<int>>("ThreadSafeNotifier", 1);
+        }
+
+        SECTION("10 subscribers")
+        {
+            benchmarkParallelNotify<ThreadSafeNotifier<int>>("ThreadSafeNotifier", 10);
+        }
+    }
+
+    SECTION("mutex based notifier")
+    {
+        SECTION("1 subscriber")
+        {
+            benchmarkParallelNotify<LockingNotifier>("Mutex based notifier", 1);
+        }
+
+        SECTION("10 subscribers")
+        {
+            benchmarkParallelNotify<LockingNotifier>("Mutex based notifier", 10);
+        }
+    }
+}
+
+#endif